@@ -0,0 +1,43 @@
+#include "common.hxx"
+#include "abstract_syntax_tree/abstract_syntax_tree.hxx"
+#include "abstract_syntax_tree/dispatch.hxx"
+#include "abstract_syntax_tree/visitor.hxx"
+#include <array>
+#include <cstddef>
+
+
+support::InternedString ast::operatorName(OperatorKind kind)
+{
+  // interned on first use, in the order of OperatorKind
+  static const std::array<support::InternedString, std::size_t(OperatorKind::Index) + 1> names{
+    support::InternedString(),
+    support::InternedString("__or__"),
+    support::InternedString("__and__"),
+    support::InternedString("__eq__"),
+    support::InternedString("__ne__"),
+    support::InternedString("__gt__"),
+    support::InternedString("__ge__"),
+    support::InternedString("__lt__"),
+    support::InternedString("__le__"),
+    support::InternedString("__add__"),
+    support::InternedString("__sub__"),
+    support::InternedString("__mul__"),
+    support::InternedString("__div__"),
+    support::InternedString("__mod__"),
+    support::InternedString("__pow__"),
+    support::InternedString("__pos__"),
+    support::InternedString("__neg__"),
+    support::InternedString("__not__"),
+    support::InternedString("__dereference__"),
+    support::InternedString("__addressof__"),
+    support::InternedString("__call__"),
+    support::InternedString("__index__")
+  };
+  return names[std::size_t(kind)];
+}
+
+
+void ast::Node::receive(Visitor& visitor)
+{
+  dispatch(this, [&](auto node) {visitor.visit(node);});
+}
@@ -1,139 +1,236 @@
 #pragma once
 #include "common.hxx"
 #include "abstract_syntax_tree/visitor.hxx"
+#include "support/stringinterner.hxx"
 #include "support/unicodecharacter.hxx"
-#include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <ostream>
-#include <string>
+#include <string_view>
 #include <utility>
-#include <vector>
 
 
 namespace ast {
 
 
+// The kinds of node there are, in the order of the Visitor's methods.
+enum class NodeKind : std::uint8_t {
+  Class, Method, Field, If, Loop, Break, Cycle, Ret, ExpressionStatement,
+  Assignment, Call, Identifier, Integer, Real, String, Character, Bool
+};
+
+
+// The operator a call was written with, for calls that the parser makes out
+// of operators. Passes that treat operators specially can switch on it
+// rather than compare names.
+enum class OperatorKind : std::uint8_t {
+  None, Or, And, Equal, NotEqual, Greater, GreaterOrEqual, Lesser,
+  LesserOrEqual, Add, Subtract, Multiply, Divide, Modulo, Power, Positive,
+  Negative, Not, Dereference, AddressOf, Call, Index
+};
+
+
+// The name of the method an operator is a call of, such as __add__ for
+// OperatorKind::Add. The name of OperatorKind::None is empty.
+support::InternedString operatorName(OperatorKind kind);
+
+
+// The children of a node, stored one after another in the ast::Context the
+// tree was built in.
+template <typename T>
+class List {
+
+public:
+
+  List() noexcept : first(nullptr), count(0) {}
+
+  List(T* first, std::size_t count) noexcept : first(first), count(count) {}
+
+  T* begin() const noexcept {return first;}
+
+  T* end() const noexcept {return first + count;}
+
+  std::size_t size() const noexcept {return count;}
+
+  bool empty() const noexcept {return count == 0;}
+
+  T& operator[](std::size_t index) const noexcept {return first[index];}
+
+private:
+
+  T* first;
+
+  std::size_t count;
+
+};
+
+
+// Nodes are created in an ast::Context, and are freed with it without being
+// destroyed one by one. They must therefore be trivially destructible.
+// A node has no vtable. It knows its kind instead, which is what isa, cast
+// and dyn_cast (in caster.hxx), ast::dispatch (in dispatch.hxx) and receive
+// look at. Each type of node has a classof that tells from the kind whether
+// a node is of that type.
 struct Node {
-  virtual ~Node() = default;
-  virtual void receive(Visitor& visitor) = 0;
+  const NodeKind kind;
+  // Calls the visitor's method for the type of this node.
+  void receive(Visitor& visitor);
+protected:
+  explicit Node(NodeKind kind) noexcept : kind(kind) {}
+  ~Node() = default;
 };
 
 
-struct GlobalStatement : Node {};
+struct GlobalStatement : Node {
+  static bool classof(const Node* node) noexcept {return node->kind <= NodeKind::Field;}
+protected:
+  using Node::Node;
+};
 
 
 struct Class final : GlobalStatement {
-  std::string name;
-  std::vector<std::unique_ptr<GlobalStatement>> body;
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  Class() noexcept : GlobalStatement(NodeKind::Class) {}
+  support::InternedString name;
+  List<GlobalStatement*> body;
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::Class;}
 };
 
 
 struct Method final : GlobalStatement {
-  std::string name;
-  std::vector<std::pair<std::string, std::unique_ptr<Expression>>> args;
-  std::unique_ptr<Expression> return_class;
-  std::vector<std::unique_ptr<Statement>> body;
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  Method() noexcept : GlobalStatement(NodeKind::Method) {}
+  support::InternedString name;
+  List<std::pair<support::InternedString, Expression*>> args;
+  Expression* return_class = nullptr;
+  List<Statement*> body;
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::Method;}
 };
 
 
 struct Field final : GlobalStatement {
-  std::string name;
-  std::unique_ptr<Expression> cls;
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  Field() noexcept : GlobalStatement(NodeKind::Field) {}
+  support::InternedString name;
+  Expression* cls = nullptr;
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::Field;}
 };
 
 
-struct Statement : Node {};
+struct Statement : Node {
+  static bool classof(const Node* node) noexcept {return node->kind >= NodeKind::If && node->kind <= NodeKind::ExpressionStatement;}
+protected:
+  using Node::Node;
+};
 
 
 struct If final : Statement {
-  std::unique_ptr<Expression> condition;
-  std::vector<std::unique_ptr<Statement>> if_body;
-  std::vector<std::pair<std::unique_ptr<Expression>, std::vector<std::unique_ptr<Statement>>>> elif_bodies;
-  std::vector<std::unique_ptr<Statement>> else_body;
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  If() noexcept : Statement(NodeKind::If) {}
+  Expression* condition = nullptr;
+  List<Statement*> if_body;
+  List<std::pair<Expression*, List<Statement*>>> elif_bodies;
+  List<Statement*> else_body;
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::If;}
 };
 
 
 struct Loop final : Statement {
-  std::vector<std::unique_ptr<Statement>> body;
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  Loop() noexcept : Statement(NodeKind::Loop) {}
+  List<Statement*> body;
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::Loop;}
 };
 
 
 struct Break final : Statement {
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  Break() noexcept : Statement(NodeKind::Break) {}
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::Break;}
 };
 
 
 struct Cycle final : Statement {
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  Cycle() noexcept : Statement(NodeKind::Cycle) {}
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::Cycle;}
 };
 
 
 struct Ret final : Statement {
-  std::unique_ptr<Expression> value;
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  Ret() noexcept : Statement(NodeKind::Ret) {}
+  Expression* value = nullptr;
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::Ret;}
 };
 
 
 struct ExpressionStatement final : Statement {
-  std::unique_ptr<Expression> value;
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  ExpressionStatement() noexcept : Statement(NodeKind::ExpressionStatement) {}
+  Expression* value = nullptr;
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::ExpressionStatement;}
 };
 
 
-struct Expression : Node {};
+struct Expression : Node {
+  static bool classof(const Node* node) noexcept {return node->kind >= NodeKind::Assignment;}
+protected:
+  using Node::Node;
+};
 
 
 struct Assignment final : Expression {
-  std::unique_ptr<Expression> left, right;
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  Assignment() noexcept : Expression(NodeKind::Assignment) {}
+  Expression* left = nullptr;
+  Expression* right = nullptr;
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::Assignment;}
 };
 
 
 struct Call final : Expression {
-  std::unique_ptr<Expression> object;
-  std::string name;
-  std::vector<std::unique_ptr<Expression>> args;
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  Call() noexcept : Expression(NodeKind::Call) {}
+  // if it is not None, 'name' is operatorName(op)
+  OperatorKind op = OperatorKind::None;
+  support::InternedString name;
+  Expression* object = nullptr;
+  List<Expression*> args;
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::Call;}
 };
 
 
 struct Identifier final : Expression {
-  std::string value;
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  Identifier() noexcept : Expression(NodeKind::Identifier) {}
+  support::InternedString value;
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::Identifier;}
 };
 
 
 struct Integer final : Expression {
+  Integer() noexcept : Expression(NodeKind::Integer) {}
   unsigned long value;
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::Integer;}
 };
 
 
 struct Real final : Expression {
+  Real() noexcept : Expression(NodeKind::Real) {}
   double value;
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::Real;}
 };
 
 
+// The text of a string literal is owned by the frontend::SourceManager the
+// program was read through, which must outlive the tree.
 struct String final : Expression {
-  std::string value;
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  String() noexcept : Expression(NodeKind::String) {}
+  std::string_view value;
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::String;}
 };
 
 
 struct Character final : Expression {
+  Character() noexcept : Expression(NodeKind::Character) {}
   support::UnicodeCharacter value;
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::Character;}
 };
 
 
 struct Bool final : Expression {
+  Bool() noexcept : Expression(NodeKind::Bool) {}
   bool value;
-  inline void receive(Visitor& visitor) override {visitor.visit(this);}
+  static bool classof(const Node* node) noexcept {return node->kind == NodeKind::Bool;}
 };
 
 
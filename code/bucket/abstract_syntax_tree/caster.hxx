@@ -1,86 +1,58 @@
 #pragma once
 #include "common.hxx"
+#include "abstract_syntax_tree/abstract_syntax_tree.hxx"
 #include <cassert>
 #include <type_traits>
 
 
-namespace ast {
-
-
-namespace {
-
-
-template <typename To>
-class Caster final : public Visitor {
-
-public:
-
-  To* result = nullptr;
-
-  void visit(Class* class_ptr) override {cast(class_ptr);}
-
-  void visit(Method* method_ptr) override {cast(method_ptr);}
-
-  void visit(Field* field_ptr) override {cast(field_ptr);}
-
-  void visit(If* if_ptr) override {cast(if_ptr);}
-
-  void visit(Loop* loop_ptr) override {cast(loop_ptr);}
-
-  void visit(Break* break_ptr) override {cast(break_ptr);}
+// Casts between the types of node, which look at the kind stored in the node
+// rather than calling through its vtable:
+//   isa<T>(node)       whether 'node' is a T
+//   cast<T>(node)      'node' as a T*, which it must be
+//   dyn_cast<T>(node)  'node' as a T*, or null if it is not one
+// None of them take a null node. A const node is cast to a const T*.
 
-  void visit(Cycle* cycle_ptr) override {cast(cycle_ptr);}
 
-  void visit(Ret* ret_ptr) override {cast(ret_ptr);}
-
-  void visit(ExpressionStatement* expression_statement_ptr) override {cast(expression_statement_ptr);}
-
-  void visit(Assignment* assignment_ptr) override {cast(assignment_ptr);}
-
-  void visit(Call* call_ptr) override {cast(call_ptr);}
-
-  void visit(Identifier* identifier_ptr) override {cast(identifier_ptr);}
+namespace ast {
 
-  void visit(Integer* integer_ptr) override {cast(integer_ptr);}
 
-  void visit(Real* real_ptr) override {cast(real_ptr);}
+namespace detail {
 
-  void visit(String* string_ptr) override {cast(string_ptr);}
 
-  void visit(Character* character_ptr) override {cast(character_ptr);}
+template <typename To, typename From>
+using CastResult = typename std::conditional<std::is_const<From>::value, const To*, To*>::type;
 
-  void visit(Bool* bool_ptr) override {cast(bool_ptr);}
 
-private:
+}
 
-  template <typename From>
-  void cast([[maybe_unused]] From* ptr)
-  {
-    if constexpr (std::is_base_of<To, From>::value)
-      result = static_cast<To*>(ptr);
-    else
-      result = nullptr;
-  }
 
-};
+template <typename To, typename From>
+bool isa(const From* node) noexcept
+{
+  static_assert(std::is_base_of<Node, To>::value);
+  static_assert(std::is_base_of<Node, From>::value);
+  assert(node);
+  if constexpr (std::is_base_of<To, From>::value)
+    return true;
+  else
+    return To::classof(node);
+}
 
 
+template <typename To, typename From>
+detail::CastResult<To, From> cast(From* node) noexcept
+{
+  assert(isa<To>(node));
+  return static_cast<detail::CastResult<To, From>>(node);
 }
 
 
-template <typename T1, typename T2>
-T1 ast_cast(T2 ptr)
+template <typename To, typename From>
+detail::CastResult<To, From> dyn_cast(From* node) noexcept
 {
-  static_assert(std::is_pointer<T1>::value);
-  static_assert(std::is_pointer<T2>::value);
-  using To = typename std::remove_pointer<T1>::type;
-  using From = typename std::remove_pointer<T2>::type;
-  static_assert(std::is_base_of<Node, To>::value);
-  static_assert(std::is_base_of<Node, From>::value);
-  Caster<To> caster;
-  ptr->receive(caster);
-  assert(caster.result == dynamic_cast<T1>(ptr));
-  return caster.result;
+  if (!isa<To>(node))
+    return nullptr;
+  return static_cast<detail::CastResult<To, From>>(node);
 }
 
 
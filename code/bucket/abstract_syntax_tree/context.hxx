@@ -0,0 +1,52 @@
+#pragma once
+#include "common.hxx"
+#include "abstract_syntax_tree/abstract_syntax_tree.hxx"
+#include "support/arena.hxx"
+#include <cstddef>
+#include <type_traits>
+
+
+namespace ast {
+
+
+// Owns every node and child list of the trees built in it, which stay valid
+// for as long as the context lives. They are all freed at once when it is
+// destroyed, however many there are.
+class Context {
+
+public:
+
+  Context() = default;
+
+  Context(const Context&) = delete;
+
+  Context& operator=(const Context&) = delete;
+
+  template <typename T>
+  T* create()
+  {
+    static_assert(std::is_base_of<Node, T>::value);
+    return arena.create<T>();
+  }
+
+  // Returns a list holding a copy of the 'count' children at 'first'.
+  template <typename T>
+  List<T> list(const T* first, std::size_t count)
+  {
+    return List<T>(arena.copy(first, count), count);
+  }
+
+  // The number of bytes the trees take up, with room not yet used.
+  std::size_t capacity() const noexcept
+  {
+    return arena.capacity();
+  }
+
+private:
+
+  support::Arena arena;
+
+};
+
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "common.hxx"
+#include "abstract_syntax_tree/abstract_syntax_tree.hxx"
+#include <cassert>
+
+
+namespace ast {
+
+
+// Calls 'function' with 'node' as a pointer to its own type, such as Call*
+// for a call, and returns what it returns. 'function' takes every type of
+// node, as a generic lambda or an overloaded function object does.
+// Where a Visitor goes through the node's vtable and then the visitor's, this
+// is one switch on the node's kind, which the compiler can inline 'function'
+// into. It is meant for passes that go over many nodes.
+template <typename Function>
+decltype(auto) dispatch(Node* node, Function&& function)
+{
+  switch (node->kind) {
+    case NodeKind::Class:
+      return function(static_cast<Class*>(node));
+    case NodeKind::Method:
+      return function(static_cast<Method*>(node));
+    case NodeKind::Field:
+      return function(static_cast<Field*>(node));
+    case NodeKind::If:
+      return function(static_cast<If*>(node));
+    case NodeKind::Loop:
+      return function(static_cast<Loop*>(node));
+    case NodeKind::Break:
+      return function(static_cast<Break*>(node));
+    case NodeKind::Cycle:
+      return function(static_cast<Cycle*>(node));
+    case NodeKind::Ret:
+      return function(static_cast<Ret*>(node));
+    case NodeKind::ExpressionStatement:
+      return function(static_cast<ExpressionStatement*>(node));
+    case NodeKind::Assignment:
+      return function(static_cast<Assignment*>(node));
+    case NodeKind::Call:
+      return function(static_cast<Call*>(node));
+    case NodeKind::Identifier:
+      return function(static_cast<Identifier*>(node));
+    case NodeKind::Integer:
+      return function(static_cast<Integer*>(node));
+    case NodeKind::Real:
+      return function(static_cast<Real*>(node));
+    case NodeKind::String:
+      return function(static_cast<String*>(node));
+    case NodeKind::Character:
+      return function(static_cast<Character*>(node));
+    default:
+      assert(node->kind == NodeKind::Bool);
+      return function(static_cast<Bool*>(node));
+  }
+}
+
+
+}
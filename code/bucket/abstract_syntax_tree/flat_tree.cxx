@@ -0,0 +1,359 @@
+#include "common.hxx"
+#include "abstract_syntax_tree/flat_tree.hxx"
+#include "abstract_syntax_tree/visitor.hxx"
+#include <limits>
+#include <stdexcept>
+using namespace ast::flat;
+
+
+// Adds each node before its children, and a node's children in order, so
+// that the arrays are in the order of a walk over the tree. The slots of a
+// node's children are taken before any of them is added, which keeps them
+// together however deep each child goes.
+class Tree::Builder final : public ast::Visitor {
+
+public:
+
+  explicit Builder(Tree& tree) noexcept;
+
+  NodeId add(ast::Node* node);
+
+  void visit(ast::Class* class_ptr) override;
+
+  void visit(ast::Method* method_ptr) override;
+
+  void visit(ast::Field* field_ptr) override;
+
+  void visit(ast::If* if_ptr) override;
+
+  void visit(ast::Loop* loop_ptr) override;
+
+  void visit(ast::Break* break_ptr) override;
+
+  void visit(ast::Cycle* cycle_ptr) override;
+
+  void visit(ast::Ret* ret_ptr) override;
+
+  void visit(ast::ExpressionStatement* expression_statement_ptr) override;
+
+  void visit(ast::Assignment* assignment_ptr) override;
+
+  void visit(ast::Call* call_ptr) override;
+
+  void visit(ast::Identifier* identifier_ptr) override;
+
+  void visit(ast::Integer* integer_ptr) override;
+
+  void visit(ast::Real* real_ptr) override;
+
+  void visit(ast::String* string_ptr) override;
+
+  void visit(ast::Character* character_ptr) override;
+
+  void visit(ast::Bool* bool_ptr) override;
+
+private:
+
+  Tree& tree;
+
+  // the id of the node that was visited last
+  NodeId added;
+
+  // Adds a node of type T, to be filled in through the returned id.
+  template <typename T>
+  NodeId reserve();
+
+  template <typename T>
+  T& node(NodeId id) noexcept;
+
+  // Takes the slots for 'count' entries of 'array'.
+  template <typename T>
+  Slice<T> reserve(std::vector<T>& array, std::size_t count);
+
+  template <typename T>
+  Slice<NodeId> addAll(const ast::List<T*>& children);
+
+};
+
+
+Tree::Builder::Builder(Tree& tree) noexcept
+: tree(tree)
+{}
+
+
+NodeId Tree::Builder::add(ast::Node* node)
+{
+  if (!node)
+    return NodeId();
+  node->receive(*this);
+  return added;
+}
+
+
+template <typename T>
+NodeId Tree::Builder::reserve()
+{
+  auto& array = std::get<std::vector<T>>(tree.nodes);
+  if (array.size() > NodeId::MAX_INDEX)
+    throw std::runtime_error("too many nodes for a flat tree");
+  array.emplace_back();
+  return NodeId(T::kind, static_cast<std::uint32_t>(array.size() - 1));
+}
+
+
+template <typename T>
+T& Tree::Builder::node(NodeId id) noexcept
+{
+  return std::get<std::vector<T>>(tree.nodes)[id.index()];
+}
+
+
+template <typename T>
+Slice<T> Tree::Builder::reserve(std::vector<T>& array, std::size_t count)
+{
+  if (count > std::numeric_limits<std::uint32_t>::max() - array.size())
+    throw std::runtime_error("too many nodes for a flat tree");
+  Slice<T> slice;
+  slice.first = static_cast<std::uint32_t>(array.size());
+  slice.count = static_cast<std::uint32_t>(count);
+  array.resize(array.size() + count);
+  return slice;
+}
+
+
+template <typename T>
+Slice<NodeId> Tree::Builder::addAll(const ast::List<T*>& children)
+{
+  auto slice = reserve(tree.edges, children.size());
+  for (std::uint32_t i = 0; i != slice.count; ++i) {
+    auto child = add(children[i]);
+    tree.edges[slice.first + i] = child;
+  }
+  return slice;
+}
+
+
+void Tree::Builder::visit(ast::Class* class_ptr)
+{
+  auto id = reserve<Class>();
+  node<Class>(id).name = class_ptr->name;
+  auto body = addAll(class_ptr->body);
+  node<Class>(id).body = body;
+  added = id;
+}
+
+
+void Tree::Builder::visit(ast::Method* method_ptr)
+{
+  auto id = reserve<Method>();
+  node<Method>(id).name = method_ptr->name;
+  auto args = reserve(tree.parameters, method_ptr->args.size());
+  for (std::uint32_t i = 0; i != args.count; ++i) {
+    auto cls = add(method_ptr->args[i].second);
+    tree.parameters[args.first + i] = Parameter{method_ptr->args[i].first, cls};
+  }
+  auto return_class = add(method_ptr->return_class);
+  auto body = addAll(method_ptr->body);
+  auto& method_node = node<Method>(id);
+  method_node.args = args;
+  method_node.return_class = return_class;
+  method_node.body = body;
+  added = id;
+}
+
+
+void Tree::Builder::visit(ast::Field* field_ptr)
+{
+  auto id = reserve<Field>();
+  auto cls = add(field_ptr->cls);
+  node<Field>(id) = Field{field_ptr->name, cls};
+  added = id;
+}
+
+
+void Tree::Builder::visit(ast::If* if_ptr)
+{
+  auto id = reserve<If>();
+  auto condition = add(if_ptr->condition);
+  auto if_body = addAll(if_ptr->if_body);
+  auto elif_bodies = reserve(tree.elifs, if_ptr->elif_bodies.size());
+  for (std::uint32_t i = 0; i != elif_bodies.count; ++i) {
+    auto elif_condition = add(if_ptr->elif_bodies[i].first);
+    auto elif_body = addAll(if_ptr->elif_bodies[i].second);
+    tree.elifs[elif_bodies.first + i] = Elif{elif_condition, elif_body};
+  }
+  auto else_body = addAll(if_ptr->else_body);
+  node<If>(id) = If{condition, if_body, elif_bodies, else_body};
+  added = id;
+}
+
+
+void Tree::Builder::visit(ast::Loop* loop_ptr)
+{
+  auto id = reserve<Loop>();
+  auto body = addAll(loop_ptr->body);
+  node<Loop>(id).body = body;
+  added = id;
+}
+
+
+void Tree::Builder::visit(ast::Break*)
+{
+  added = reserve<Break>();
+}
+
+
+void Tree::Builder::visit(ast::Cycle*)
+{
+  added = reserve<Cycle>();
+}
+
+
+void Tree::Builder::visit(ast::Ret* ret_ptr)
+{
+  auto id = reserve<Ret>();
+  auto value = add(ret_ptr->value);
+  node<Ret>(id).value = value;
+  added = id;
+}
+
+
+void Tree::Builder::visit(ast::ExpressionStatement* expression_statement_ptr)
+{
+  auto id = reserve<ExpressionStatement>();
+  auto value = add(expression_statement_ptr->value);
+  node<ExpressionStatement>(id).value = value;
+  added = id;
+}
+
+
+void Tree::Builder::visit(ast::Assignment* assignment_ptr)
+{
+  auto id = reserve<Assignment>();
+  auto left = add(assignment_ptr->left);
+  auto right = add(assignment_ptr->right);
+  node<Assignment>(id) = Assignment{left, right};
+  added = id;
+}
+
+
+void Tree::Builder::visit(ast::Call* call_ptr)
+{
+  auto id = reserve<Call>();
+  auto object = add(call_ptr->object);
+  auto args = addAll(call_ptr->args);
+  node<Call>(id) = Call{object, call_ptr->name, args, call_ptr->op};
+  added = id;
+}
+
+
+void Tree::Builder::visit(ast::Identifier* identifier_ptr)
+{
+  added = reserve<Identifier>();
+  node<Identifier>(added).value = identifier_ptr->value;
+}
+
+
+void Tree::Builder::visit(ast::Integer* integer_ptr)
+{
+  added = reserve<Integer>();
+  node<Integer>(added).value = integer_ptr->value;
+}
+
+
+void Tree::Builder::visit(ast::Real* real_ptr)
+{
+  added = reserve<Real>();
+  node<Real>(added).value = real_ptr->value;
+}
+
+
+void Tree::Builder::visit(ast::String* string_ptr)
+{
+  added = reserve<String>();
+  node<String>(added).value = string_ptr->value;
+}
+
+
+void Tree::Builder::visit(ast::Character* character_ptr)
+{
+  added = reserve<Character>();
+  node<Character>(added).value = character_ptr->value;
+}
+
+
+void Tree::Builder::visit(ast::Bool* bool_ptr)
+{
+  added = reserve<Bool>();
+  node<Bool>(added).value = bool_ptr->value;
+}
+
+
+Tree::Tree(ast::Class* program)
+{
+  root_id = Builder(*this).add(program);
+}
+
+
+std::size_t Tree::size() const noexcept
+{
+  return std::apply([](auto&... arrays) {return (arrays.size() + ...);}, nodes);
+}
+
+
+void Tree::receive(NodeId id, Visitor& visitor) const
+{
+  switch (id.kind()) {
+    case NodeKind::Class:
+      visitor.visit(get<Class>(id));
+      break;
+    case NodeKind::Method:
+      visitor.visit(get<Method>(id));
+      break;
+    case NodeKind::Field:
+      visitor.visit(get<Field>(id));
+      break;
+    case NodeKind::If:
+      visitor.visit(get<If>(id));
+      break;
+    case NodeKind::Loop:
+      visitor.visit(get<Loop>(id));
+      break;
+    case NodeKind::Break:
+      visitor.visit(get<Break>(id));
+      break;
+    case NodeKind::Cycle:
+      visitor.visit(get<Cycle>(id));
+      break;
+    case NodeKind::Ret:
+      visitor.visit(get<Ret>(id));
+      break;
+    case NodeKind::ExpressionStatement:
+      visitor.visit(get<ExpressionStatement>(id));
+      break;
+    case NodeKind::Assignment:
+      visitor.visit(get<Assignment>(id));
+      break;
+    case NodeKind::Call:
+      visitor.visit(get<Call>(id));
+      break;
+    case NodeKind::Identifier:
+      visitor.visit(get<Identifier>(id));
+      break;
+    case NodeKind::Integer:
+      visitor.visit(get<Integer>(id));
+      break;
+    case NodeKind::Real:
+      visitor.visit(get<Real>(id));
+      break;
+    case NodeKind::String:
+      visitor.visit(get<String>(id));
+      break;
+    case NodeKind::Character:
+      visitor.visit(get<Character>(id));
+      break;
+    case NodeKind::Bool:
+      visitor.visit(get<Bool>(id));
+      break;
+  }
+}
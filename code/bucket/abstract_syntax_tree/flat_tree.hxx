@@ -0,0 +1,325 @@
+#pragma once
+#include "common.hxx"
+#include "abstract_syntax_tree/abstract_syntax_tree.hxx"
+#include "support/stringinterner.hxx"
+#include "support/unicodecharacter.hxx"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+
+// A flat tree holds the same program as a tree of ast::Nodes, but every kind
+// of node is kept in an array of its own, and nodes refer to each other by
+// 32-bit ids instead of pointers. The children of a node are a slice of one
+// array of ids shared by the whole tree. Nodes are laid out in the order in
+// which a visitor walks them, so a walk reads each array from front to back.
+
+
+namespace ast::flat {
+
+
+// Names a node by its kind, in the top five bits, and its index among the
+// nodes of that kind, in the rest.
+class NodeId {
+
+public:
+
+  static constexpr unsigned INDEX_BITS = 27;
+
+  static constexpr std::uint32_t MAX_INDEX = (std::uint32_t(1) << INDEX_BITS) - 1;
+
+  // The id of no node, such as the value of a 'ret' without one.
+  NodeId() noexcept : value(NONE) {}
+
+  NodeId(NodeKind kind, std::uint32_t index) noexcept : value(std::uint32_t(kind) << INDEX_BITS | index) {}
+
+  bool isValid() const noexcept {return value != NONE;}
+
+  NodeKind kind() const noexcept {return NodeKind(value >> INDEX_BITS);}
+
+  std::uint32_t index() const noexcept {return value & MAX_INDEX;}
+
+private:
+
+  static constexpr std::uint32_t NONE = ~std::uint32_t(0);
+
+  std::uint32_t value;
+
+};
+
+
+// The entries 'first' to 'first + count' of one of the tree's arrays.
+template <typename T>
+struct Slice {
+  std::uint32_t first = 0;
+  std::uint32_t count = 0;
+};
+
+
+struct Parameter {
+  support::InternedString name;
+  NodeId cls;
+};
+
+
+struct Elif {
+  NodeId condition;
+  Slice<NodeId> body;
+};
+
+
+struct Class {
+  static constexpr NodeKind kind = NodeKind::Class;
+  support::InternedString name;
+  Slice<NodeId> body;
+};
+
+
+struct Method {
+  static constexpr NodeKind kind = NodeKind::Method;
+  support::InternedString name;
+  Slice<Parameter> args;
+  NodeId return_class;
+  Slice<NodeId> body;
+};
+
+
+struct Field {
+  static constexpr NodeKind kind = NodeKind::Field;
+  support::InternedString name;
+  NodeId cls;
+};
+
+
+struct If {
+  static constexpr NodeKind kind = NodeKind::If;
+  NodeId condition;
+  Slice<NodeId> if_body;
+  Slice<Elif> elif_bodies;
+  Slice<NodeId> else_body;
+};
+
+
+struct Loop {
+  static constexpr NodeKind kind = NodeKind::Loop;
+  Slice<NodeId> body;
+};
+
+
+struct Break {
+  static constexpr NodeKind kind = NodeKind::Break;
+};
+
+
+struct Cycle {
+  static constexpr NodeKind kind = NodeKind::Cycle;
+};
+
+
+struct Ret {
+  static constexpr NodeKind kind = NodeKind::Ret;
+  NodeId value;
+};
+
+
+struct ExpressionStatement {
+  static constexpr NodeKind kind = NodeKind::ExpressionStatement;
+  NodeId value;
+};
+
+
+struct Assignment {
+  static constexpr NodeKind kind = NodeKind::Assignment;
+  NodeId left;
+  NodeId right;
+};
+
+
+struct Call {
+  static constexpr NodeKind kind = NodeKind::Call;
+  NodeId object;
+  support::InternedString name;
+  Slice<NodeId> args;
+  OperatorKind op;
+};
+
+
+struct Identifier {
+  static constexpr NodeKind kind = NodeKind::Identifier;
+  support::InternedString value;
+};
+
+
+struct Integer {
+  static constexpr NodeKind kind = NodeKind::Integer;
+  unsigned long value;
+};
+
+
+struct Real {
+  static constexpr NodeKind kind = NodeKind::Real;
+  double value;
+};
+
+
+struct String {
+  static constexpr NodeKind kind = NodeKind::String;
+  std::string_view value;
+};
+
+
+struct Character {
+  static constexpr NodeKind kind = NodeKind::Character;
+  support::UnicodeCharacter value;
+};
+
+
+struct Bool {
+  static constexpr NodeKind kind = NodeKind::Bool;
+  bool value;
+};
+
+
+// Has the same methods as ast::Visitor. A visitor that needs to go on to the
+// children of a node is given the tree when it is made, and passes their ids
+// to Tree::receive.
+class Visitor {
+
+public:
+
+  virtual ~Visitor() = default;
+
+  virtual void visit(const Class& class_node) = 0;
+
+  virtual void visit(const Method& method_node) = 0;
+
+  virtual void visit(const Field& field_node) = 0;
+
+  virtual void visit(const If& if_node) = 0;
+
+  virtual void visit(const Loop& loop_node) = 0;
+
+  virtual void visit(const Break& break_node) = 0;
+
+  virtual void visit(const Cycle& cycle_node) = 0;
+
+  virtual void visit(const Ret& ret_node) = 0;
+
+  virtual void visit(const ExpressionStatement& expression_statement_node) = 0;
+
+  virtual void visit(const Assignment& assignment_node) = 0;
+
+  virtual void visit(const Call& call_node) = 0;
+
+  virtual void visit(const Identifier& identifier_node) = 0;
+
+  virtual void visit(const Integer& integer_node) = 0;
+
+  virtual void visit(const Real& real_node) = 0;
+
+  virtual void visit(const String& string_node) = 0;
+
+  virtual void visit(const Character& character_node) = 0;
+
+  virtual void visit(const Bool& bool_node) = 0;
+
+protected:
+
+  Visitor() = default;
+
+};
+
+
+class Tree {
+
+public:
+
+  // Copies the tree of ast::Nodes under 'program', which is left as it is.
+  explicit Tree(ast::Class* program);
+
+  // The id of the module class.
+  NodeId root() const noexcept;
+
+  // The total number of nodes.
+  std::size_t size() const noexcept;
+
+  // Returns the node 'id', which must be of type T.
+  template <typename T>
+  const T& get(NodeId id) const noexcept;
+
+  template <typename T>
+  List<const T> get(Slice<T> slice) const noexcept;
+
+  // Calls the visitor's method for the node 'id'.
+  void receive(NodeId id, Visitor& visitor) const;
+
+private:
+
+  class Builder;
+
+  std::tuple<
+    std::vector<Class>, std::vector<Method>, std::vector<Field>,
+    std::vector<If>, std::vector<Loop>, std::vector<Break>, std::vector<Cycle>,
+    std::vector<Ret>, std::vector<ExpressionStatement>,
+    std::vector<Assignment>, std::vector<Call>, std::vector<Identifier>,
+    std::vector<Integer>, std::vector<Real>, std::vector<String>,
+    std::vector<Character>, std::vector<Bool>
+  > nodes;
+
+  std::vector<NodeId> edges;
+
+  std::vector<Parameter> parameters;
+
+  std::vector<Elif> elifs;
+
+  NodeId root_id;
+
+  // The array that slices of T are taken from.
+  template <typename T>
+  const std::vector<T>& array() const noexcept;
+
+};
+
+
+std::ostream& operator<<(std::ostream& stream, const Tree& tree);
+
+
+inline NodeId Tree::root() const noexcept
+{
+  return root_id;
+}
+
+
+template <typename T>
+const T& Tree::get(NodeId id) const noexcept
+{
+  assert(id.kind() == T::kind);
+  return std::get<std::vector<T>>(nodes)[id.index()];
+}
+
+
+template <typename T>
+List<const T> Tree::get(Slice<T> slice) const noexcept
+{
+  return List<const T>(array<T>().data() + slice.first, slice.count);
+}
+
+
+template <typename T>
+const std::vector<T>& Tree::array() const noexcept
+{
+  if constexpr (std::is_same<T, NodeId>::value)
+    return edges;
+  else if constexpr (std::is_same<T, Parameter>::value)
+    return parameters;
+  else
+    return elifs;
+}
+
+
+}
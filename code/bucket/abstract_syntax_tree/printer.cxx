@@ -1,6 +1,7 @@
 #include "common.hxx"
 #include "abstract_syntax_tree/abstract_syntax_tree.hxx"
 #include "abstract_syntax_tree/visitor.hxx"
+#include "abstract_syntax_tree/flat_tree.hxx"
 using namespace ast;
 
 
@@ -225,6 +226,219 @@ void Printer::visit(Bool* bool_ptr)
 }
 
 
+// Prints a flat tree exactly as Printer prints the tree it was made from.
+class FlatPrinter final : public flat::Visitor {
+
+public:
+
+  FlatPrinter(std::ostream& stream, const flat::Tree& tree) noexcept;
+
+  void visit(const flat::Class& class_node) override;
+
+  void visit(const flat::Method& method_node) override;
+
+  void visit(const flat::Field& field_node) override;
+
+  void visit(const flat::If& if_node) override;
+
+  void visit(const flat::Loop& loop_node) override;
+
+  void visit(const flat::Break& break_node) override;
+
+  void visit(const flat::Cycle& cycle_node) override;
+
+  void visit(const flat::Ret& ret_node) override;
+
+  void visit(const flat::ExpressionStatement& expression_statement_node) override;
+
+  void visit(const flat::Assignment& assignment_node) override;
+
+  void visit(const flat::Call& call_node) override;
+
+  void visit(const flat::Identifier& identifier_node) override;
+
+  void visit(const flat::Integer& integer_node) override;
+
+  void visit(const flat::Real& real_node) override;
+
+  void visit(const flat::String& string_node) override;
+
+  void visit(const flat::Character& character_node) override;
+
+  void visit(const flat::Bool& bool_node) override;
+
+private:
+
+  std::ostream& stream;
+
+  const flat::Tree& tree;
+
+};
+
+
+FlatPrinter::FlatPrinter(std::ostream& stream, const flat::Tree& tree) noexcept
+: stream(stream),
+  tree(tree)
+{}
+
+
+void FlatPrinter::visit(const flat::Class& class_node)
+{
+  stream << "class " << class_node.name << '\n';
+  for (auto global_statement : tree.get(class_node.body))
+    tree.receive(global_statement, *this);
+  stream << "end" << '\n';
+}
+
+
+void FlatPrinter::visit(const flat::Method& method_node)
+{
+  stream << "method " << method_node.name << '(';
+  auto args = tree.get(method_node.args);
+  for (auto iter = args.begin(); iter != args.end(); ++iter) {
+    if (iter != args.begin())
+      stream << ", ";
+    stream << iter->name << " : ";
+    tree.receive(iter->cls, *this);
+  }
+  stream << ')';
+  if (method_node.return_class.isValid()) {
+    stream << " : ";
+    tree.receive(method_node.return_class, *this);
+  }
+  stream << '\n';
+  for (auto statement : tree.get(method_node.body))
+    tree.receive(statement, *this);
+  stream << "end\n";
+}
+
+
+void FlatPrinter::visit(const flat::Field& field_node)
+{
+  stream << field_node.name << " : ";
+  tree.receive(field_node.cls, *this);
+  stream << '\n';
+}
+
+
+void FlatPrinter::visit(const flat::If& if_node)
+{
+  stream << "if ";
+  tree.receive(if_node.condition, *this);
+  stream << '\n';
+  for (auto statement : tree.get(if_node.if_body))
+    tree.receive(statement, *this);
+  for (auto& elif_body : tree.get(if_node.elif_bodies)) {
+    stream << "elif ";
+    tree.receive(elif_body.condition, *this);
+    stream << '\n';
+    for (auto statement : tree.get(elif_body.body))
+      tree.receive(statement, *this);
+  }
+  for (auto statement : tree.get(if_node.else_body))
+    tree.receive(statement, *this);
+  stream << "end\n";
+}
+
+
+void FlatPrinter::visit(const flat::Loop& loop_node)
+{
+  stream << "do\n";
+  for (auto statement : tree.get(loop_node.body))
+    tree.receive(statement, *this);
+  stream << "end\n";
+}
+
+
+void FlatPrinter::visit(const flat::Break&)
+{
+  stream << "break\n";
+}
+
+
+void FlatPrinter::visit(const flat::Cycle&)
+{
+  stream << "cycle\n";
+}
+
+
+void FlatPrinter::visit(const flat::Ret& ret_node)
+{
+  stream << "ret";
+  if (ret_node.value.isValid()) {
+    stream << ' ';
+    tree.receive(ret_node.value, *this);
+  }
+  stream << '\n';
+}
+
+
+void FlatPrinter::visit(const flat::ExpressionStatement& expression_statement_node)
+{
+  tree.receive(expression_statement_node.value, *this);
+  stream << '\n';
+}
+
+
+void FlatPrinter::visit(const flat::Assignment& assignment_node)
+{
+  tree.receive(assignment_node.left, *this);
+  stream << " = ";
+  tree.receive(assignment_node.right, *this);
+  stream << '\n';
+}
+
+
+void FlatPrinter::visit(const flat::Call& call_node)
+{
+  tree.receive(call_node.object, *this);
+  stream << '.' << call_node.name << '(';
+  auto args = tree.get(call_node.args);
+  for (auto iter = args.begin(); iter != args.end(); ++iter) {
+    if (iter != args.begin())
+      stream << ", ";
+    tree.receive(*iter, *this);
+  }
+  stream << ")\n";
+}
+
+
+void FlatPrinter::visit(const flat::Identifier& identifier_node)
+{
+  stream << identifier_node.value;
+}
+
+
+void FlatPrinter::visit(const flat::Integer& integer_node)
+{
+  stream << integer_node.value;
+}
+
+
+void FlatPrinter::visit(const flat::Real& real_node)
+{
+  stream << real_node.value;
+}
+
+
+void FlatPrinter::visit(const flat::String& string_node)
+{
+  stream << string_node.value;
+}
+
+
+void FlatPrinter::visit(const flat::Character& character_node)
+{
+  stream << character_node.value;
+}
+
+
+void FlatPrinter::visit(const flat::Bool& bool_node)
+{
+  stream << (bool_node.value ? "true" : "false");
+}
+
+
 }
 
 
@@ -234,3 +448,11 @@ std::ostream& ast::operator<<(std::ostream& stream, Node& node)
   node.receive(visitor);
   return stream;
 }
+
+
+std::ostream& ast::flat::operator<<(std::ostream& stream, const Tree& tree)
+{
+  FlatPrinter visitor{stream, tree};
+  tree.receive(tree.root(), visitor);
+  return stream;
+}
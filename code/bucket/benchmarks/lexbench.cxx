@@ -0,0 +1,493 @@
+// lexbench.cxx
+// Measures how fast source text is turned into tokens, both one token at a
+// time through frontend::Lexer and all at once into a frontend::TokenBuffer,
+// with one thread and with one thread per core.
+// The text is either read from files or generated (--corpus), and is held in
+// memory before timing starts, so that only lexing is measured. The best of
+// five runs is reported in tokens per second and megabytes per second, along
+// with the number of allocations per token; --json prints the same as JSON.
+// A generated corpus mixes lines of the named kinds: identifiers, numeric,
+// literals, comments, unicode (non-ASCII identifiers) and nested (block
+// comments).
+// Usage: bucket_lexbench [--json] paths...
+//        bucket_lexbench [--json] --corpus name[,name...] [megabytes]
+
+#include "common.hxx"
+#include "frontend/lexer.hxx"
+#include "frontend/sourcemanager.hxx"
+#include "frontend/tokenbuffer.hxx"
+#include "support/concatenate.hxx"
+#include "support/mappedfile.hxx"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+struct Input {
+  std::string name;
+  std::string contents;
+};
+
+
+struct Totals {
+  std::size_t bytes = 0;
+  std::size_t tokens = 0;
+  std::size_t allocations = 0;
+};
+
+
+// Every allocation in the program is counted, so that the ones made while
+// lexing can be reported per token.
+static std::atomic<std::size_t> allocations{0};
+
+
+void* operator new(std::size_t size)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* memory = std::malloc(size ? size : 1))
+    return memory;
+  throw std::bad_alloc();
+}
+
+
+void operator delete(void* memory) noexcept
+{
+  std::free(memory);
+}
+
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+  std::free(memory);
+}
+
+
+// The corpora are made of lines, each written by one of these generators.
+// Their content is random but the same from run to run.
+using Generator = std::mt19937;
+
+
+static void appendIdentifier(Generator& generator, std::string& line)
+{
+  static const char* const words[] = {"value", "count", "index", "node", "left", "right", "total", "buffer", "item", "next", "size", "x", "y", "i"};
+  std::uniform_int_distribution<std::size_t> word{0, std::size(words) - 1};
+  std::uniform_int_distribution<int> suffix{0, 99};
+  line += words[word(generator)];
+  if (auto number = suffix(generator); number < 40) {
+    line += '_';
+    line += std::to_string(number);
+  }
+}
+
+
+static void appendNumber(Generator& generator, std::string& line)
+{
+  std::uniform_int_distribution<int> form{0, 5};
+  std::uniform_int_distribution<unsigned long> integer{0, 4294967295ul};
+  std::uniform_int_distribution<int> digits{1, 9};
+  std::uniform_int_distribution<int> exponent{-30, 30};
+  auto value = integer(generator);
+  switch (form(generator)) {
+    case 0:
+      line += std::to_string(value % 100);
+      break;
+    case 1:
+      line += std::to_string(value);
+      break;
+    case 2:
+      line += std::to_string(value % 1000) + '.' + std::to_string(value % 100000);
+      break;
+    case 3:
+      line += '.' + std::to_string(value).substr(0, digits(generator));
+      break;
+    case 4:
+      line += std::to_string(value % 10) + '.' + std::to_string(value).substr(0, digits(generator)) + 'e' + std::to_string(exponent(generator));
+      break;
+    default:
+      line += std::to_string(value % 1000) + "E+" + std::to_string(value % 20);
+      break;
+  }
+}
+
+
+static void appendText(Generator& generator, std::string& line, std::size_t length)
+{
+  static const char letters[] = "abcdefghijklmnopqrstuvwxyz     ";
+  std::uniform_int_distribution<std::size_t> letter{0, sizeof(letters) - 2};
+  for (std::size_t i = 0; i != length; ++i)
+    line += letters[letter(generator)];
+}
+
+
+// Calls and assignments with many names and few literals.
+static void identifierLine(Generator& generator, std::string& line)
+{
+  std::uniform_int_distribution<int> arguments{0, 4};
+  line += "  ";
+  appendIdentifier(generator, line);
+  line += " = ";
+  appendIdentifier(generator, line);
+  line += '.';
+  appendIdentifier(generator, line);
+  line += '(';
+  for (int i = arguments(generator); i > 0; --i) {
+    appendIdentifier(generator, line);
+    if (i != 1)
+      line += ", ";
+  }
+  line += ")\n";
+}
+
+
+// Data tables: rows of integer and real literals in all of their forms.
+static void numericLine(Generator& generator, std::string& line)
+{
+  line += "  row(";
+  for (int column = 0; column != 8; ++column) {
+    if (column != 0)
+      line += ", ";
+    appendNumber(generator, line);
+  }
+  line += ")\n";
+}
+
+
+// Rows of literals of every kind: numbers, strings with and without escape
+// sequences, characters and booleans.
+static void literalLine(Generator& generator, std::string& line)
+{
+  std::uniform_int_distribution<int> kind{0, 5};
+  std::uniform_int_distribution<std::size_t> length{0, 40};
+  static const char* const escapes[] = {"\\n", "\\t", "\\\"", "\\\\"};
+  std::uniform_int_distribution<std::size_t> escape{0, std::size(escapes) - 1};
+  line += "  row(";
+  for (int column = 0; column != 6; ++column) {
+    if (column != 0)
+      line += ", ";
+    switch (kind(generator)) {
+      case 0:
+      case 1:
+        appendNumber(generator, line);
+        break;
+      case 2:
+        line += '"';
+        appendText(generator, line, length(generator));
+        line += '"';
+        break;
+      case 3:
+        line += '"';
+        appendText(generator, line, length(generator) / 2);
+        line += escapes[escape(generator)];
+        appendText(generator, line, length(generator) / 2);
+        line += '"';
+        break;
+      case 4:
+        line += '\'';
+        appendText(generator, line, 1);
+        line += '\'';
+        break;
+      default:
+        line += length(generator) % 2 ? "true" : "false";
+        break;
+    }
+  }
+  line += ")\n";
+}
+
+
+// Code that is mostly explained: line comments, block comments, and
+// indentation.
+static void commentLine(Generator& generator, std::string& line)
+{
+  std::uniform_int_distribution<int> kind{0, 3};
+  std::uniform_int_distribution<std::size_t> length{10, 80};
+  std::uniform_int_distribution<std::size_t> indentation{0, 4};
+  line.append(4 * indentation(generator), ' ');
+  switch (kind(generator)) {
+    case 0:
+    case 1:
+      line += "// ";
+      appendText(generator, line, length(generator));
+      line += '\n';
+      break;
+    case 2:
+      line += "/* ";
+      appendText(generator, line, length(generator));
+      line += "\n   ";
+      appendText(generator, line, length(generator));
+      line += " */\n";
+      break;
+    default:
+      appendIdentifier(generator, line);
+      line += " = ";
+      appendIdentifier(generator, line);
+      line += "  // ";
+      appendText(generator, line, length(generator) / 2);
+      line += '\n';
+      break;
+  }
+}
+
+
+// Names in other scripts, which leave the lexer's tables.
+static void unicodeLine(Generator& generator, std::string& line)
+{
+  static const char* const syllables[] = {"größe", "straße", "δέλτα", "λόγος", "μῆκος", "длина", "узел", "世界", "長さ", "値", "naïve", "café", "x"};
+  std::uniform_int_distribution<std::size_t> syllable{0, std::size(syllables) - 1};
+  std::uniform_int_distribution<int> count{1, 3};
+  auto appendName = [&] {
+    for (int i = count(generator); i > 0; --i)
+      line += syllables[syllable(generator)];
+  };
+  line += "  ";
+  appendName();
+  line += " = ";
+  appendName();
+  line += " + ";
+  appendName();
+  line += '\n';
+}
+
+
+// Block comments nested up to sixteen deep, some of them over several lines.
+static void nestedCommentLine(Generator& generator, std::string& line)
+{
+  std::uniform_int_distribution<int> depth{1, 16};
+  std::uniform_int_distribution<std::size_t> length{0, 20};
+  auto levels = depth(generator);
+  for (int i = 0; i != levels; ++i) {
+    line += "/* ";
+    appendText(generator, line, length(generator));
+    if (length(generator) < 3)
+      line += '\n';
+  }
+  for (int i = 0; i != levels; ++i) {
+    appendText(generator, line, length(generator));
+    line += " */";
+  }
+  line += '\n';
+}
+
+
+struct Corpus {
+  const char* name;
+  void (*line)(Generator&, std::string&);
+};
+
+static const Corpus corpora[] = {
+  {"identifiers", identifierLine},
+  {"numeric", numericLine},
+  {"literals", literalLine},
+  {"comments", commentLine},
+  {"unicode", unicodeLine},
+  {"nested", nestedCommentLine}
+};
+
+
+// Generates about 'size' bytes of lines from the named corpora, which are
+// separated by commas and picked from at random for each line.
+static std::string generateCorpus(const std::string& names, std::size_t size)
+{
+  std::vector<const Corpus*> mix;
+  std::size_t name_start = 0;
+  while (name_start <= names.size()) {
+    auto name_end = std::min(names.find(',', name_start), names.size());
+    auto name = names.substr(name_start, name_end - name_start);
+    auto corpus = std::find_if(std::begin(corpora), std::end(corpora), [&](const Corpus& corpus) { return name == corpus.name; });
+    if (corpus == std::end(corpora))
+      throw std::runtime_error(support::concatenate("unknown corpus ", name.c_str(), " (the corpora are identifiers, numeric, literals, comments, unicode and nested)"));
+    mix.push_back(corpus);
+    name_start = name_end + 1;
+  }
+
+  Generator generator{42};
+  std::uniform_int_distribution<std::size_t> pick{0, mix.size() - 1};
+  std::string text;
+  text.reserve(size + 4096);
+  while (text.size() < size)
+    mix[pick(generator)]->line(generator, text);
+  return text;
+}
+
+
+static std::string readFile(const std::string& path)
+{
+  support::MappedFile file{path.c_str()};
+  return std::string(reinterpret_cast<const char*>(file.data()), file.size());
+}
+
+
+// Counts the tokens before the end-of-file token.
+static std::size_t lex(frontend::SourceManager& source_manager, frontend::SourceManager::FileId file)
+{
+  std::size_t tokens = 0;
+  frontend::Lexer lexer{source_manager, file};
+  while (!(lexer.currentToken().getSymbol() && *lexer.currentToken().getSymbol() == frontend::Symbol::EndOfFile)) {
+    ++tokens;
+    lexer.next();
+  }
+  return tokens;
+}
+
+
+static std::size_t buffer(frontend::SourceManager& source_manager, frontend::SourceManager::FileId file)
+{
+  frontend::TokenBuffer tokens{source_manager, file};
+  tokens.throwIfIncomplete();
+  return tokens.size() - 1;
+}
+
+
+static std::size_t bufferInParallel(frontend::SourceManager& source_manager, frontend::SourceManager::FileId file)
+{
+  frontend::TokenBuffer tokens{source_manager, file, std::thread::hardware_concurrency()};
+  tokens.throwIfIncomplete();
+  return tokens.size() - 1;
+}
+
+
+struct Result {
+  const char* name;
+  double seconds;
+  Totals totals;
+};
+
+
+// Returns the best of five runs. The allocations are those of the last run.
+template <typename Function>
+static Result measure(const char* name, const std::vector<Input>& inputs, Function count_tokens)
+{
+  Result result{name, 1e300, {}};
+  for (int run = 0; run != 5; ++run) {
+    frontend::SourceManager source_manager;
+    std::vector<frontend::SourceManager::FileId> files;
+    for (auto& input : inputs) {
+      auto contents = std::make_unique<unsigned char[]>(input.contents.size());
+      std::memcpy(contents.get(), input.contents.data(), input.contents.size());
+      files.push_back(source_manager.addFile(input.name, std::move(contents), input.contents.size()));
+    }
+
+    result.totals = Totals();
+    auto allocations_before = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (auto file : files)
+      result.totals.tokens += count_tokens(source_manager, file);
+    auto stop = std::chrono::steady_clock::now();
+    result.totals.allocations = allocations.load() - allocations_before;
+    for (auto& input : inputs)
+      result.totals.bytes += input.contents.size();
+    std::chrono::duration<double> seconds = stop - start;
+    result.seconds = std::min(result.seconds, seconds.count());
+  }
+  return result;
+}
+
+
+static double allocationsPerToken(const Totals& totals)
+{
+  return totals.tokens ? static_cast<double>(totals.allocations) / static_cast<double>(totals.tokens) : 0.0;
+}
+
+
+static void printTable(const std::vector<Result>& results)
+{
+  std::cout << std::fixed << std::setprecision(2);
+  for (auto& result : results) {
+    auto& totals = result.totals;
+    std::cout << std::left << std::setw(14) << result.name << std::right
+              << std::setw(10) << result.seconds * 1e3 << " ms"
+              << std::setw(10) << totals.tokens / result.seconds / 1e6 << " Mtokens/s"
+              << std::setw(10) << totals.bytes / result.seconds / 1e6 << " MB/s"
+              << std::setw(10) << allocationsPerToken(totals) << " allocations/token"
+              << "   (" << totals.tokens << " tokens, " << totals.bytes << " bytes)\n";
+  }
+}
+
+
+static std::string jsonString(const std::string& string)
+{
+  std::string json = "\"";
+  for (char c : string) {
+    if (c == '"' || c == '\\')
+      json += '\\';
+    json += c;
+  }
+  return json + '"';
+}
+
+
+// One object, so that runs can be kept and compared by scripts.
+static void printJson(const std::vector<Input>& inputs, const std::vector<Result>& results)
+{
+  std::cout << std::setprecision(6) << "{\n  \"inputs\": [";
+  for (std::size_t i = 0; i != inputs.size(); ++i)
+    std::cout << (i ? ", " : "") << jsonString(inputs[i].name);
+  std::cout << "],\n  \"results\": [";
+  for (std::size_t i = 0; i != results.size(); ++i) {
+    auto& result = results[i];
+    auto& totals = result.totals;
+    std::cout << (i ? "," : "") << "\n    {"
+              << "\"name\": " << jsonString(result.name)
+              << ", \"bytes\": " << totals.bytes
+              << ", \"tokens\": " << totals.tokens
+              << ", \"seconds\": " << result.seconds
+              << ", \"megabytes_per_second\": " << totals.bytes / result.seconds / 1e6
+              << ", \"tokens_per_second\": " << totals.tokens / result.seconds
+              << ", \"allocations_per_token\": " << allocationsPerToken(totals)
+              << "}";
+  }
+  std::cout << "\n  ]\n}\n";
+}
+
+
+static void main_with_exceptions(int argc, char* argv[])
+{
+  bool json = argc >= 2 && std::strcmp(argv[1], "--json") == 0;
+  std::vector<Input> inputs;
+  if (argc >= 3 + json && std::strcmp(argv[1 + json], "--corpus") == 0 && argc <= 4 + json) {
+    std::size_t megabytes = argc == 4 + json ? std::strtoul(argv[3 + json], nullptr, 10) : 16;
+    inputs.push_back({support::concatenate("<", argv[2 + json], ">"), generateCorpus(argv[2 + json], megabytes << 20)});
+  }
+  else if (argc >= 2 + json && argv[1 + json][0] != '-') {
+    for (int i = 1 + json; i != argc; ++i)
+      inputs.push_back({argv[i], readFile(argv[i])});
+  }
+  else
+    throw std::runtime_error("usage: bucket_lexbench [--json] paths... | bucket_lexbench [--json] --corpus names [megabytes]");
+
+  std::vector<Result> results;
+  results.push_back(measure("lexer", inputs, lex));
+  results.push_back(measure("token buffer", inputs, buffer));
+  results.push_back(measure("parallel", inputs, bufferInParallel));
+  if (json)
+    printJson(inputs, results);
+  else
+    printTable(results);
+}
+
+
+int main(int argc, char* argv[]) noexcept
+{
+  try {
+    main_with_exceptions(argc, argv);
+    return 0;
+  } catch (std::exception& e) {
+    std::cerr << "bucket_lexbench: \033[31merror:\033[0m " << e.what() << '\n';
+    return 1;
+  }
+}
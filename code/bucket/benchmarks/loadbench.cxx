@@ -0,0 +1,131 @@
+// loadbench.cxx
+// Measures how long it takes to load a set of files: one after another through
+// MappedFile, and concurrently through each supported FileLoader method. With
+// --cold, the files are evicted from the page cache before every run (where
+// the platform allows it), so that the disk is measured rather than memory.
+// Usage: bucket_loadbench [--cold] paths...
+
+#include "common.hxx"
+#include "support/fileloader.hxx"
+#include "support/mappedfile.hxx"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef BUCKET_HAVE_POSIX
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+
+struct Totals {
+  std::size_t bytes = 0;
+  std::uint64_t checksum = 0;
+};
+
+
+// Every byte is touched, so that mapped files are actually read.
+static void add(Totals& totals, const unsigned char* data, std::size_t size)
+{
+  std::uint64_t sum = 0;
+  for (std::size_t i = 0; i != size; ++i)
+    sum += data[i];
+  totals.bytes += size;
+  totals.checksum += sum;
+}
+
+
+static void evict(const std::vector<std::string>& paths)
+{
+  #ifdef BUCKET_HAVE_POSIX
+  for (auto& path : paths) {
+    int file_descriptor = ::open(path.c_str(), O_RDONLY);
+    if (file_descriptor == -1)
+      continue;
+    ::fdatasync(file_descriptor);
+    ::posix_fadvise(file_descriptor, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(file_descriptor);
+  }
+  #else
+  static_cast<void>(paths);
+  #endif
+}
+
+
+static Totals loadSequentially(const std::vector<std::string>& paths)
+{
+  Totals totals;
+  for (auto& path : paths) {
+    support::MappedFile file{path.c_str()};
+    add(totals, file.data(), file.size());
+  }
+  return totals;
+}
+
+
+static Totals loadConcurrently(const std::vector<std::string>& paths, support::FileLoaderMethod method)
+{
+  Totals totals;
+  support::FileLoader loader{paths, method};
+  while (auto file = loader.next())
+    add(totals, file->contents.get(), file->size);
+  return totals;
+}
+
+
+template <typename Function>
+static void measure(const char* name, const std::vector<std::string>& paths, bool cold, const Totals* expected, Totals& result, Function load)
+{
+  double best = 1e300;
+  for (int run = 0; run != 3; ++run) {
+    if (cold)
+      evict(paths);
+    auto start = std::chrono::steady_clock::now();
+    result = load();
+    auto stop = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::milli> milliseconds = stop - start;
+    best = std::min(best, milliseconds.count());
+  }
+  if (expected && (expected->bytes != result.bytes || expected->checksum != result.checksum))
+    throw std::runtime_error(std::string(name) + " loaded different contents");
+  std::cout << std::left << std::setw(12) << name << std::right << std::setw(10) << best << " ms\n";
+}
+
+
+static void main_with_exceptions(int argc, char* argv[])
+{
+  bool cold = argc >= 2 && std::strcmp(argv[1], "--cold") == 0;
+  std::vector<std::string> paths{argv + 1 + cold, argv + argc};
+  if (paths.empty())
+    throw std::runtime_error("usage: bucket_loadbench [--cold] paths...");
+
+  std::cout << std::fixed << std::setprecision(2);
+  Totals sequential;
+  measure("sequential", paths, cold, nullptr, sequential, [&] { return loadSequentially(paths); });
+  for (auto method : {support::FileLoaderMethod::ThreadPool, support::FileLoaderMethod::IoUring}) {
+    if (!support::isFileLoaderMethodSupported(method))
+      continue;
+    Totals concurrent;
+    auto name = std::string(support::fileLoaderMethodToString(method));
+    measure(name.c_str(), paths, cold, &sequential, concurrent, [&] { return loadConcurrently(paths, method); });
+  }
+  std::cout << paths.size() << " files, " << sequential.bytes << " bytes\n";
+}
+
+
+int main(int argc, char* argv[]) noexcept
+{
+  try {
+    main_with_exceptions(argc, argv);
+    return 0;
+  } catch (std::exception& e) {
+    std::cerr << "bucket_loadbench: \033[31merror:\033[0m " << e.what() << '\n';
+    return 1;
+  }
+}
@@ -0,0 +1,688 @@
+// parsebench.cxx
+// Measures how fast source text is parsed into a tree, how fast the tree is
+// freed, and what the tree costs in allocations and memory. It also times a
+// walk over every node of the tree, once with a Visitor and once with
+// ast::dispatch, and one over the same tree converted to an ast::flat::Tree.
+// The text is either read from files or generated (--synthetic), and is held
+// in memory before timing starts. Parsing includes lexing into the token
+// buffer. The best of five runs is reported, along with the number of
+// allocations and bytes allocated while parsing, and how much the peak
+// resident set size grew during the first run.
+// A synthetic program is made of classes with fields and methods, whose
+// bodies mix assignments, calls, loops and returns. An expression-dense one
+// (--expressions) is made of methods that assign long chains of operators
+// of every precedence, with operands that are mostly single names.
+// Usage: bucket_parsebench paths...
+//        bucket_parsebench --synthetic [megabytes]
+//        bucket_parsebench --expressions [megabytes]
+
+#include "common.hxx"
+#include "abstract_syntax_tree/context.hxx"
+#include "abstract_syntax_tree/dispatch.hxx"
+#include "abstract_syntax_tree/flat_tree.hxx"
+#include "abstract_syntax_tree/visitor.hxx"
+#include "frontend/parser.hxx"
+#include "frontend/sourcemanager.hxx"
+#include "support/mappedfile.hxx"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#ifdef BUCKET_HAVE_POSIX
+  #include <sys/resource.h>
+#endif
+
+
+struct Input {
+  std::string name;
+  std::string contents;
+};
+
+
+// Every allocation in the program is counted, so that the ones made while
+// parsing can be reported.
+static std::atomic<std::size_t> allocations{0};
+
+static std::atomic<std::size_t> allocated_bytes{0};
+
+
+void* operator new(std::size_t size)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (void* memory = std::malloc(size ? size : 1))
+    return memory;
+  throw std::bad_alloc();
+}
+
+
+void operator delete(void* memory) noexcept
+{
+  std::free(memory);
+}
+
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+  std::free(memory);
+}
+
+
+// The largest resident set size of the process so far, in bytes, or zero
+// where it cannot be found.
+static std::size_t peakResidentSetSize()
+{
+#ifdef BUCKET_HAVE_POSIX
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+  return 0;
+}
+
+
+// The synthetic program is random but the same from run to run.
+using Generator = std::mt19937;
+
+
+static void appendName(Generator& generator, std::string& text)
+{
+  static const char* const words[] = {"value", "count", "index", "node", "left", "right", "total", "buffer", "item", "next", "size", "x", "y", "i"};
+  std::uniform_int_distribution<std::size_t> word{0, std::size(words) - 1};
+  text += words[word(generator)];
+}
+
+
+static void appendExpression(Generator& generator, std::string& text, int depth)
+{
+  static const char* const operators[] = {" + ", " - ", " * ", " / ", " % ", " ^ ", " == ", " != ", " < ", " >= ", " or "};
+  std::uniform_int_distribution<int> form{0, depth > 0 ? 6 : 2};
+  std::uniform_int_distribution<std::size_t> op{0, std::size(operators) - 1};
+  std::uniform_int_distribution<int> number{0, 999};
+  std::uniform_int_distribution<int> arguments{0, 3};
+  switch (form(generator)) {
+    case 0:
+      appendName(generator, text);
+      break;
+    case 1:
+      text += std::to_string(number(generator));
+      break;
+    case 2:
+      text += '"';
+      appendName(generator, text);
+      text += '"';
+      break;
+    case 3:
+    case 4:
+      // comparisons do not chain, so each operation is parenthesized
+      text += '(';
+      appendExpression(generator, text, depth - 1);
+      text += operators[op(generator)];
+      appendExpression(generator, text, depth - 1);
+      text += ')';
+      break;
+    case 5:
+      appendName(generator, text);
+      text += '.';
+      appendName(generator, text);
+      text += '(';
+      for (int i = arguments(generator); i > 0; --i) {
+        appendExpression(generator, text, depth - 1);
+        if (i != 1)
+          text += ", ";
+      }
+      text += ')';
+      break;
+    default:
+      text += '(';
+      appendExpression(generator, text, depth - 1);
+      text += ")[";
+      appendExpression(generator, text, depth - 1);
+      text += ']';
+      break;
+  }
+}
+
+
+static void appendStatements(Generator& generator, std::string& text, int indentation, int depth)
+{
+  std::uniform_int_distribution<int> count{1, 6};
+  std::uniform_int_distribution<int> form{0, depth > 0 ? 7 : 5};
+  for (int i = count(generator); i > 0; --i) {
+    text.append(indentation, ' ');
+    switch (form(generator)) {
+      case 0:
+      case 1:
+      case 2:
+        appendName(generator, text);
+        text += " = ";
+        appendExpression(generator, text, 3);
+        text += '\n';
+        break;
+      case 3:
+      case 4:
+        appendName(generator, text);
+        text += '(';
+        appendExpression(generator, text, 2);
+        text += ")\n";
+        break;
+      case 5:
+        text += "ret ";
+        appendExpression(generator, text, 2);
+        text += '\n';
+        break;
+      default:
+        text += "do\n";
+        appendStatements(generator, text, indentation + 2, depth - 1);
+        text.append(indentation + 2, ' ');
+        text += depth % 2 ? "break\n" : "cycle\n";
+        text.append(indentation, ' ');
+        text += "end\n";
+        break;
+    }
+  }
+}
+
+
+// Generates about 'size' bytes of classes.
+static std::string generateProgram(std::size_t size)
+{
+  Generator generator{42};
+  std::uniform_int_distribution<int> members{1, 4};
+  std::uniform_int_distribution<int> parameters{0, 3};
+  std::string text;
+  text.reserve(size + 65536);
+  for (std::size_t i = 0; text.size() < size; ++i) {
+    text += "class C" + std::to_string(i) + '\n';
+    for (int j = members(generator); j > 0; --j) {
+      appendName(generator, text);
+      text += " : Int\n";
+    }
+    for (int j = members(generator); j > 0; --j) {
+      text += "method m" + std::to_string(j) + '(';
+      for (int k = parameters(generator); k > 0; --k) {
+        appendName(generator, text);
+        text += k % 2 ? " : Int" : " : Real";
+        if (k != 1)
+          text += ", ";
+      }
+      text += ") : Int\n";
+      appendStatements(generator, text, 2, 3);
+      text += "end\n";
+    }
+    text += "end\n";
+  }
+  return text;
+}
+
+
+// An operand, perhaps with a unary operator, and a chain of binary operators
+// and further operands after it. Comparisons do not chain, so there is at
+// most one of them outside of parentheses.
+static void appendChain(Generator& generator, std::string& text, int depth)
+{
+  static const char* const arithmetic[] = {" + ", " - ", " * ", " / ", " % ", " ^ "};
+  static const char* const logical[] = {" or ", " == ", " != ", " < ", " <= ", " > ", " >= "};
+  static const char* const prefixes[] = {"-", "+", "not ", "*", "&"};
+  std::uniform_int_distribution<int> length{1, 6};
+  std::uniform_int_distribution<int> form{0, 15};
+  std::uniform_int_distribution<std::size_t> arithmetic_operator{0, std::size(arithmetic) - 1};
+  std::uniform_int_distribution<std::size_t> logical_operator{0, std::size(logical) - 1};
+  std::uniform_int_distribution<std::size_t> prefix{0, std::size(prefixes) - 1};
+  std::uniform_int_distribution<int> number{0, 99};
+  auto appendOperand = [&] {
+    switch (form(generator)) {
+      case 0:
+        text += std::to_string(number(generator));
+        break;
+      case 1:
+        text += prefixes[prefix(generator)];
+        appendName(generator, text);
+        break;
+      case 2:
+        appendName(generator, text);
+        text += '.';
+        appendName(generator, text);
+        break;
+      case 3:
+        if (depth > 0) {
+          text += '(';
+          appendChain(generator, text, depth - 1);
+          text += ')';
+          break;
+        }
+        [[fallthrough]];
+      default:
+        appendName(generator, text);
+        break;
+    }
+  };
+  appendOperand();
+  bool compared = false;
+  for (int i = length(generator); i > 0; --i) {
+    if (!compared && form(generator) < 3) {
+      auto op = logical[logical_operator(generator)];
+      compared = op[1] != 'o';
+      text += op;
+    }
+    else
+      text += arithmetic[arithmetic_operator(generator)];
+    appendOperand();
+  }
+}
+
+
+// Generates about 'size' bytes of methods made of assignments.
+static std::string generateExpressions(std::size_t size)
+{
+  Generator generator{42};
+  std::uniform_int_distribution<int> statements{4, 12};
+  std::string text;
+  text.reserve(size + 65536);
+  for (std::size_t i = 0; text.size() < size; ++i) {
+    text += "method m" + std::to_string(i) + "()\n";
+    for (int j = statements(generator); j > 0; --j) {
+      text += "  ";
+      appendName(generator, text);
+      text += " = ";
+      appendChain(generator, text, 2);
+      text += '\n';
+    }
+    text += "end\n";
+  }
+  return text;
+}
+
+
+static std::string readFile(const std::string& path)
+{
+  support::MappedFile file{path.c_str()};
+  return std::string(reinterpret_cast<const char*>(file.data()), file.size());
+}
+
+
+// Counts the nodes of a tree, as a pass that looks at all of them would
+// visit them.
+class NodeCounter final : public ast::Visitor {
+
+public:
+
+  std::size_t nodes = 0;
+
+  void visit(ast::Class* class_ptr) override {++nodes; visitAll(class_ptr->body);}
+
+  void visit(ast::Method* method_ptr) override
+  {
+    ++nodes;
+    for (auto& arg : method_ptr->args)
+      visit(arg.second);
+    visit(method_ptr->return_class);
+    visitAll(method_ptr->body);
+  }
+
+  void visit(ast::Field* field_ptr) override {++nodes; visit(field_ptr->cls);}
+
+  void visit(ast::If* if_ptr) override
+  {
+    ++nodes;
+    visit(if_ptr->condition);
+    visitAll(if_ptr->if_body);
+    for (auto& elif_body : if_ptr->elif_bodies) {
+      visit(elif_body.first);
+      visitAll(elif_body.second);
+    }
+    visitAll(if_ptr->else_body);
+  }
+
+  void visit(ast::Loop* loop_ptr) override {++nodes; visitAll(loop_ptr->body);}
+
+  void visit(ast::Break*) override {++nodes;}
+
+  void visit(ast::Cycle*) override {++nodes;}
+
+  void visit(ast::Ret* ret_ptr) override {++nodes; visit(ret_ptr->value);}
+
+  void visit(ast::ExpressionStatement* expression_statement_ptr) override {++nodes; visit(expression_statement_ptr->value);}
+
+  void visit(ast::Assignment* assignment_ptr) override {++nodes; visit(assignment_ptr->left); visit(assignment_ptr->right);}
+
+  void visit(ast::Call* call_ptr) override {++nodes; visit(call_ptr->object); visitAll(call_ptr->args);}
+
+  void visit(ast::Identifier*) override {++nodes;}
+
+  void visit(ast::Integer*) override {++nodes;}
+
+  void visit(ast::Real*) override {++nodes;}
+
+  void visit(ast::String*) override {++nodes;}
+
+  void visit(ast::Character*) override {++nodes;}
+
+  void visit(ast::Bool*) override {++nodes;}
+
+private:
+
+  void visit(ast::Node* node)
+  {
+    if (node)
+      node->receive(*this);
+  }
+
+  template <typename T>
+  void visitAll(const ast::List<T*>& nodes)
+  {
+    for (auto node : nodes)
+      node->receive(*this);
+  }
+
+};
+
+
+// Counts the same nodes as NodeCounter, but gets from a node to its type
+// with ast::dispatch instead of the node's receive.
+class SwitchNodeCounter {
+
+public:
+
+  std::size_t nodes = 0;
+
+  void count(ast::Node* node)
+  {
+    if (node)
+      ast::dispatch(node, *this);
+  }
+
+  void operator()(ast::Class* class_ptr) {++nodes; countAll(class_ptr->body);}
+
+  void operator()(ast::Method* method_ptr)
+  {
+    ++nodes;
+    for (auto& arg : method_ptr->args)
+      count(arg.second);
+    count(method_ptr->return_class);
+    countAll(method_ptr->body);
+  }
+
+  void operator()(ast::Field* field_ptr) {++nodes; count(field_ptr->cls);}
+
+  void operator()(ast::If* if_ptr)
+  {
+    ++nodes;
+    count(if_ptr->condition);
+    countAll(if_ptr->if_body);
+    for (auto& elif_body : if_ptr->elif_bodies) {
+      count(elif_body.first);
+      countAll(elif_body.second);
+    }
+    countAll(if_ptr->else_body);
+  }
+
+  void operator()(ast::Loop* loop_ptr) {++nodes; countAll(loop_ptr->body);}
+
+  void operator()(ast::Break*) {++nodes;}
+
+  void operator()(ast::Cycle*) {++nodes;}
+
+  void operator()(ast::Ret* ret_ptr) {++nodes; count(ret_ptr->value);}
+
+  void operator()(ast::ExpressionStatement* expression_statement_ptr) {++nodes; count(expression_statement_ptr->value);}
+
+  void operator()(ast::Assignment* assignment_ptr) {++nodes; count(assignment_ptr->left); count(assignment_ptr->right);}
+
+  void operator()(ast::Call* call_ptr) {++nodes; count(call_ptr->object); countAll(call_ptr->args);}
+
+  void operator()(ast::Identifier*) {++nodes;}
+
+  void operator()(ast::Integer*) {++nodes;}
+
+  void operator()(ast::Real*) {++nodes;}
+
+  void operator()(ast::String*) {++nodes;}
+
+  void operator()(ast::Character*) {++nodes;}
+
+  void operator()(ast::Bool*) {++nodes;}
+
+private:
+
+  template <typename T>
+  void countAll(const ast::List<T*>& nodes)
+  {
+    for (auto node : nodes)
+      ast::dispatch(node, *this);
+  }
+
+};
+
+
+class FlatNodeCounter final : public ast::flat::Visitor {
+
+public:
+
+  std::size_t nodes = 0;
+
+  explicit FlatNodeCounter(const ast::flat::Tree& tree) noexcept : tree(tree) {}
+
+  void visit(const ast::flat::Class& class_node) override {++nodes; visitAll(class_node.body);}
+
+  void visit(const ast::flat::Method& method_node) override
+  {
+    ++nodes;
+    for (auto& arg : tree.get(method_node.args))
+      visit(arg.cls);
+    visit(method_node.return_class);
+    visitAll(method_node.body);
+  }
+
+  void visit(const ast::flat::Field& field_node) override {++nodes; visit(field_node.cls);}
+
+  void visit(const ast::flat::If& if_node) override
+  {
+    ++nodes;
+    visit(if_node.condition);
+    visitAll(if_node.if_body);
+    for (auto& elif_body : tree.get(if_node.elif_bodies)) {
+      visit(elif_body.condition);
+      visitAll(elif_body.body);
+    }
+    visitAll(if_node.else_body);
+  }
+
+  void visit(const ast::flat::Loop& loop_node) override {++nodes; visitAll(loop_node.body);}
+
+  void visit(const ast::flat::Break&) override {++nodes;}
+
+  void visit(const ast::flat::Cycle&) override {++nodes;}
+
+  void visit(const ast::flat::Ret& ret_node) override {++nodes; visit(ret_node.value);}
+
+  void visit(const ast::flat::ExpressionStatement& expression_statement_node) override {++nodes; visit(expression_statement_node.value);}
+
+  void visit(const ast::flat::Assignment& assignment_node) override {++nodes; visit(assignment_node.left); visit(assignment_node.right);}
+
+  void visit(const ast::flat::Call& call_node) override {++nodes; visit(call_node.object); visitAll(call_node.args);}
+
+  void visit(const ast::flat::Identifier&) override {++nodes;}
+
+  void visit(const ast::flat::Integer&) override {++nodes;}
+
+  void visit(const ast::flat::Real&) override {++nodes;}
+
+  void visit(const ast::flat::String&) override {++nodes;}
+
+  void visit(const ast::flat::Character&) override {++nodes;}
+
+  void visit(const ast::flat::Bool&) override {++nodes;}
+
+private:
+
+  const ast::flat::Tree& tree;
+
+  void visit(ast::flat::NodeId id)
+  {
+    if (id.isValid())
+      tree.receive(id, *this);
+  }
+
+  void visitAll(ast::flat::Slice<ast::flat::NodeId> slice)
+  {
+    for (auto id : tree.get(slice))
+      tree.receive(id, *this);
+  }
+
+};
+
+
+struct Result {
+  std::size_t bytes = 0;
+  std::size_t nodes = 0;
+  double parse_seconds = 1e300;
+  double free_seconds = 1e300;
+  double walk_seconds = 1e300;
+  double switch_walk_seconds = 1e300;
+  double convert_seconds = 1e300;
+  double flat_walk_seconds = 1e300;
+  std::size_t allocations = 0;
+  std::size_t allocated_bytes = 0;
+  std::size_t peak_growth = 0;
+};
+
+
+// Returns the best of five runs. The allocations are those of the last run.
+static Result measure(const std::vector<Input>& inputs)
+{
+  Result result;
+  for (auto& input : inputs)
+    result.bytes += input.contents.size();
+  for (int run = 0; run != 5; ++run) {
+    frontend::SourceManager source_manager;
+    std::vector<frontend::SourceManager::FileId> files;
+    for (auto& input : inputs) {
+      auto contents = std::make_unique<unsigned char[]>(input.contents.size());
+      std::memcpy(contents.get(), input.contents.data(), input.contents.size());
+      files.push_back(source_manager.addFile(input.name, std::move(contents), input.contents.size()));
+    }
+
+    auto peak_before = peakResidentSetSize();
+    auto allocations_before = allocations.load();
+    auto allocated_bytes_before = allocated_bytes.load();
+    auto start = std::chrono::steady_clock::now();
+    std::optional<ast::Context> context{std::in_place};
+    std::vector<ast::Class*> programs;
+    for (auto file : files) {
+      frontend::Parser parser{*context, source_manager, file};
+      programs.push_back(parser.parse());
+    }
+    auto parsed = std::chrono::steady_clock::now();
+    result.allocations = allocations.load() - allocations_before;
+    result.allocated_bytes = allocated_bytes.load() - allocated_bytes_before;
+    // the peak only grows, so the later runs reuse the memory of the first
+    if (run == 0)
+      result.peak_growth = peakResidentSetSize() - peak_before;
+
+    NodeCounter counter;
+    for (auto program : programs)
+      counter.visit(program);
+    auto walked = std::chrono::steady_clock::now();
+    SwitchNodeCounter switch_counter;
+    for (auto program : programs)
+      switch_counter.count(program);
+    auto switch_walked = std::chrono::steady_clock::now();
+    if (switch_counter.nodes != counter.nodes)
+      throw std::runtime_error("the walks with a visitor and with a switch do not count the same nodes");
+    std::vector<ast::flat::Tree> trees;
+    for (auto program : programs)
+      trees.emplace_back(program);
+    auto converted = std::chrono::steady_clock::now();
+    std::size_t flat_nodes = 0;
+    for (auto& tree : trees) {
+      FlatNodeCounter flat_counter{tree};
+      tree.receive(tree.root(), flat_counter);
+      flat_nodes += flat_counter.nodes;
+    }
+    auto flat_walked = std::chrono::steady_clock::now();
+    if (flat_nodes != counter.nodes)
+      throw std::runtime_error("the flat trees do not have as many nodes as the trees they were made from");
+    result.nodes = counter.nodes;
+    trees.clear();
+
+    auto freeing = std::chrono::steady_clock::now();
+    context.reset();
+    auto freed = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double> parse_seconds = parsed - start;
+    std::chrono::duration<double> walk_seconds = walked - parsed;
+    std::chrono::duration<double> switch_walk_seconds = switch_walked - walked;
+    std::chrono::duration<double> convert_seconds = converted - switch_walked;
+    std::chrono::duration<double> flat_walk_seconds = flat_walked - converted;
+    std::chrono::duration<double> free_seconds = freed - freeing;
+    result.parse_seconds = std::min(result.parse_seconds, parse_seconds.count());
+    result.walk_seconds = std::min(result.walk_seconds, walk_seconds.count());
+    result.switch_walk_seconds = std::min(result.switch_walk_seconds, switch_walk_seconds.count());
+    result.convert_seconds = std::min(result.convert_seconds, convert_seconds.count());
+    result.flat_walk_seconds = std::min(result.flat_walk_seconds, flat_walk_seconds.count());
+    result.free_seconds = std::min(result.free_seconds, free_seconds.count());
+  }
+  return result;
+}
+
+
+static void main_with_exceptions(int argc, char* argv[])
+{
+  std::vector<Input> inputs;
+  if (argc >= 2 && argc <= 3 && std::strcmp(argv[1], "--synthetic") == 0) {
+    std::size_t megabytes = argc == 3 ? std::strtoul(argv[2], nullptr, 10) : 16;
+    inputs.push_back({"<synthetic>", generateProgram(megabytes << 20)});
+  }
+  else if (argc >= 2 && argc <= 3 && std::strcmp(argv[1], "--expressions") == 0) {
+    std::size_t megabytes = argc == 3 ? std::strtoul(argv[2], nullptr, 10) : 16;
+    inputs.push_back({"<expressions>", generateExpressions(megabytes << 20)});
+  }
+  else if (argc >= 2 && argv[1][0] != '-') {
+    for (int i = 1; i != argc; ++i)
+      inputs.push_back({argv[i], readFile(argv[i])});
+  }
+  else
+    throw std::runtime_error("usage: bucket_parsebench paths... | bucket_parsebench --synthetic [megabytes] | bucket_parsebench --expressions [megabytes]");
+
+  auto result = measure(inputs);
+  std::cout << std::fixed << std::setprecision(2)
+            << "bytes:           " << result.bytes << '\n'
+            << "nodes:           " << result.nodes << '\n'
+            << "parse:           " << result.parse_seconds * 1e3 << " ms (" << result.bytes / result.parse_seconds / 1e6 << " MB/s)\n"
+            << "walk:            " << result.walk_seconds * 1e3 << " ms\n"
+            << "walk switch:     " << result.switch_walk_seconds * 1e3 << " ms\n"
+            << "flatten:         " << result.convert_seconds * 1e3 << " ms\n"
+            << "walk flat:       " << result.flat_walk_seconds * 1e3 << " ms\n"
+            << "free:            " << result.free_seconds * 1e3 << " ms\n"
+            << "allocations:     " << result.allocations << '\n'
+            << "allocated bytes: " << result.allocated_bytes << '\n'
+            << "peak RSS growth: " << result.peak_growth / 1e6 << " MB\n"
+            << "peak RSS:        " << peakResidentSetSize() / 1e6 << " MB\n";
+}
+
+
+int main(int argc, char* argv[]) noexcept
+{
+  try {
+    main_with_exceptions(argc, argv);
+    return 0;
+  } catch (std::exception& e) {
+    std::cerr << "bucket_parsebench: \033[31merror:\033[0m " << e.what() << '\n';
+    return 1;
+  }
+}
@@ -0,0 +1,133 @@
+// utf8bench.cxx
+// Measures the throughput of each UTF-8 validator on an ASCII-heavy corpus
+// (source code with the odd non-ASCII identifier) and a CJK-heavy corpus
+// (mostly three byte sequences). Usage: bucket_utf8bench [megabytes]
+
+#include "common.hxx"
+#include "support/utf8.hxx"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+static std::string asciiHeavyCorpus(std::size_t size)
+{
+  static const char* const lines[] = {
+    "method area(width : Real, height : Real) : Real\n",
+    "  ret width * height\n",
+    "end\n",
+    "  count = count + 1 // increment the counter\n",
+    "  name = \"a string literal with some words in it\"\n",
+    "  \xce\xb4\xce\xad\xce\xbb\xcf\x84\xce\xb1 = values[index].scale(2.5e3)\n",
+    "/* a block comment describing the next class */\n",
+  };
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<std::size_t> pick{0, std::size(lines) - 1};
+  std::string corpus;
+  corpus.reserve(size + 128);
+  while (corpus.size() < size)
+    corpus += lines[pick(generator)];
+  return corpus;
+}
+
+
+static std::string cjkHeavyCorpus(std::size_t size)
+{
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int> pick{0x4E00, 0x9FFF};
+  std::string corpus;
+  corpus.reserve(size + 128);
+  for (std::size_t i = 0; corpus.size() < size; ++i) {
+    if (i % 40 == 39) {
+      corpus += '\n';
+      continue;
+    }
+    auto code_point = pick(generator);
+    corpus += static_cast<char>(0xE0 | (code_point >> 12));
+    corpus += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    corpus += static_cast<char>(0x80 | (code_point & 0x3F));
+  }
+  return corpus;
+}
+
+
+static double gigabytesPerSecond(const std::string& corpus, support::Utf8Validator validator)
+{
+  auto data = reinterpret_cast<const unsigned char*>(corpus.data());
+  double best = 0;
+  for (int run = 0; run != 5; ++run) {
+    auto start = std::chrono::steady_clock::now();
+    auto offset = support::findInvalidUtf8(data, corpus.size(), validator);
+    auto stop = std::chrono::steady_clock::now();
+    if (offset != corpus.size())
+      throw std::runtime_error("benchmark corpus failed validation");
+    std::chrono::duration<double> seconds = stop - start;
+    best = std::max(best, static_cast<double>(corpus.size()) / seconds.count() / 1e9);
+  }
+  return best;
+}
+
+
+// Every validator has to report the same offset for the same broken input;
+// this is checked on a sample of corrupted copies of the corpus.
+static void checkAgreement(const std::string& corpus)
+{
+  std::mt19937 generator{7};
+  std::uniform_int_distribution<std::size_t> position{0, corpus.size() - 1};
+  std::uniform_int_distribution<int> byte{0x80, 0xFF};
+  for (int trial = 0; trial != 200; ++trial) {
+    auto broken = corpus.substr(0, 4096);
+    broken[position(generator) % broken.size()] = static_cast<char>(byte(generator));
+    auto data = reinterpret_cast<const unsigned char*>(broken.data());
+    auto expected = support::findInvalidUtf8(data, broken.size(), support::Utf8Validator::Scalar);
+    for (auto validator : {support::Utf8Validator::SSE2, support::Utf8Validator::AVX2})
+      if (support::isUtf8ValidatorSupported(validator) && support::findInvalidUtf8(data, broken.size(), validator) != expected)
+        throw std::runtime_error("validators disagree on the offset of an invalid sequence");
+  }
+}
+
+
+static void main_with_exceptions(int argc, char* argv[])
+{
+  std::size_t megabytes = 64;
+  if (argc == 2)
+    megabytes = std::strtoul(argv[1], nullptr, 10);
+  else if (argc != 1)
+    throw std::runtime_error("usage: bucket_utf8bench [megabytes]");
+  auto size = megabytes << 20;
+
+  const std::pair<const char*, std::string> corpora[] = {
+    {"ascii-heavy", asciiHeavyCorpus(size)},
+    {"cjk-heavy", cjkHeavyCorpus(size)},
+  };
+
+  std::cout << std::fixed << std::setprecision(2);
+  for (auto& [name, corpus] : corpora) {
+    checkAgreement(corpus);
+    for (auto validator : {support::Utf8Validator::Scalar, support::Utf8Validator::SSE2, support::Utf8Validator::AVX2}) {
+      if (!support::isUtf8ValidatorSupported(validator))
+        continue;
+      std::cout << std::left << std::setw(12) << name << ' ' << std::setw(7) << support::utf8ValidatorToString(validator)
+                << std::right << std::setw(8) << gigabytesPerSecond(corpus, validator) << " GB/s\n";
+    }
+  }
+}
+
+
+int main(int argc, char* argv[]) noexcept
+{
+  try {
+    main_with_exceptions(argc, argv);
+    return 0;
+  } catch (std::exception& e) {
+    std::cerr << "bucket_utf8bench: \033[31merror:\033[0m " << e.what() << '\n';
+    return 1;
+  }
+}
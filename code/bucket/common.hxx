@@ -17,6 +17,15 @@
 //   BUCKET_RESTRICT - if compiler extensions are enabled and the compiler in
 //     use has a keyword analogous to 'restrict' in C, BUCKET_RESTRICT is set to
 //     that keyword. Otherwise the macro is defined but empty.
+//   BUCKET_HAVE_POSIX - defined if the POSIX file APIs (open, read, fstat,
+//     mmap) are available.
+//   BUCKET_HAVE_X86_SIMD - defined if compiler extensions are enabled, the
+//     target is x86-64, and the compiler supports per-function target
+//     attributes. Code may then contain SSE2 and AVX2 kernels, as long as they
+//     are only called after checking the CPU at runtime.
+//   BUCKET_HAVE_IO_URING - defined if compiler extensions are enabled, the
+//     target is Linux, and the kernel headers declare io_uring. Whether the
+//     running kernel supports it must still be checked at runtime.
 
 #ifndef BUCKET_DISABLE_COMPILER_EXTENSIONS
   #ifdef __clang__
@@ -35,4 +44,18 @@
   #define BUCKET_RESTRICT
 #endif
 
+#if defined(__unix__) || defined(__APPLE__)
+  #define BUCKET_HAVE_POSIX
+#endif
+
+#if (defined(BUCKET_COMPILER_IS_CLANG) || defined(BUCKET_COMPILER_IS_GCC)) && defined(__x86_64__)
+  #define BUCKET_HAVE_X86_SIMD
+#endif
+
+#if (defined(BUCKET_COMPILER_IS_CLANG) || defined(BUCKET_COMPILER_IS_GCC)) && defined(__linux__)
+  #if __has_include(<linux/io_uring.h>)
+    #define BUCKET_HAVE_IO_URING
+  #endif
+#endif
+
 #endif
@@ -4,6 +4,7 @@
 #include "compiler_objects/method.hxx"
 #include "abstract_syntax_tree/abstract_syntax_tree.hxx"
 #include "abstract_syntax_tree/caster.hxx"
+#include "abstract_syntax_tree/flat_tree.hxx"
 #include "support/concatenate.hxx"
 #include <stdexcept>
 #include <utility>
@@ -16,10 +17,16 @@ Class::Class(Scope* parent_scope, ast::Class* cls)
 {}
 
 
+Class::Class(Scope* parent_scope, const ast::flat::Class& cls)
+: Scope(parent_scope),
+  name(cls.name)
+{}
+
+
 void Class::init(ast::Class* cls)
 {
   for (auto& global_statement : cls->body) {
-    if (auto class_ptr = ast::ast_cast<ast::Class*>(global_statement.get())) {
+    if (auto class_ptr = ast::dyn_cast<ast::Class>(global_statement)) {
       auto& entry = map[class_ptr->name];
       if (entry)
         throw std::runtime_error(support::concatenate("ERROR REDEFINING NAME"));
@@ -27,22 +34,63 @@ void Class::init(ast::Class* cls)
       ptr->init(class_ptr);
       entry = addToModuleFreeList(std::move(ptr));
     }
-    else if (auto method_ptr = ast::ast_cast<ast::Method*>(global_statement.get())) {
+    else if (auto method_ptr = ast::dyn_cast<ast::Method>(global_statement)) {
       auto& entry = map[method_ptr->name];
       if (entry)
         throw std::runtime_error(support::concatenate("ERROR REDEFINING NAME"));
       std::vector<Class*> argument_classes;
       for (auto& arg : method_ptr->args)
-        argument_classes.push_back(lookupClass(arg.second.get()));
-      entry = addToModuleFreeList(std::make_unique<Method>(this, method_ptr->name, std::move(argument_classes), lookupClass(method_ptr->return_class.get())));
+        argument_classes.push_back(lookupClass(arg.second));
+      entry = addToModuleFreeList(std::make_unique<Method>(this, method_ptr->name, std::move(argument_classes), lookupClass(method_ptr->return_class)));
     }
     else {
-      assert(ast::ast_cast<ast::Field*>(global_statement.get()));
-      auto field_ptr = static_cast<ast::Field*>(global_statement.get());
+      auto field_ptr = ast::cast<ast::Field>(global_statement);
       auto& entry = map[field_ptr->name];
       if (entry)
         throw std::runtime_error(support::concatenate("ERROR REDEFINING NAME"));
-      entry = addToModuleFreeList(std::make_unique<Field>(this, field_ptr->name, lookupClass(field_ptr->cls.get())));
+      entry = addToModuleFreeList(std::make_unique<Field>(this, field_ptr->name, lookupClass(field_ptr->cls)));
+    }
+  }
+}
+
+
+void Class::init(const ast::flat::Tree& tree, const ast::flat::Class& cls)
+{
+  for (auto global_statement : tree.get(cls.body)) {
+    switch (global_statement.kind()) {
+      case ast::NodeKind::Class:
+        {
+          auto& class_node = tree.get<ast::flat::Class>(global_statement);
+          auto& entry = map[class_node.name];
+          if (entry)
+            throw std::runtime_error(support::concatenate("ERROR REDEFINING NAME"));
+          auto ptr = std::make_unique<Class>(this, class_node);
+          ptr->init(tree, class_node);
+          entry = addToModuleFreeList(std::move(ptr));
+          break;
+        }
+      case ast::NodeKind::Method:
+        {
+          auto& method_node = tree.get<ast::flat::Method>(global_statement);
+          auto& entry = map[method_node.name];
+          if (entry)
+            throw std::runtime_error(support::concatenate("ERROR REDEFINING NAME"));
+          std::vector<Class*> argument_classes;
+          for (auto& arg : tree.get(method_node.args))
+            argument_classes.push_back(lookupClass(tree, arg.cls));
+          entry = addToModuleFreeList(std::make_unique<Method>(this, method_node.name, std::move(argument_classes), lookupClass(tree, method_node.return_class)));
+          break;
+        }
+      default:
+        {
+          assert(global_statement.kind() == ast::NodeKind::Field);
+          auto& field_node = tree.get<ast::flat::Field>(global_statement);
+          auto& entry = map[field_node.name];
+          if (entry)
+            throw std::runtime_error(support::concatenate("ERROR REDEFINING NAME"));
+          entry = addToModuleFreeList(std::make_unique<Field>(this, field_node.name, lookupClass(tree, field_node.cls)));
+          break;
+        }
     }
   }
 }
@@ -10,6 +10,14 @@ struct Class;
 }
 
 
+namespace ast::flat {
+
+struct Class;
+class Tree;
+
+}
+
+
 namespace cobjs {
 
 
@@ -19,13 +27,18 @@ public:
 
   Class(Scope* parent_scope, ast::Class* cls);
 
+  Class(Scope* parent_scope, const ast::flat::Class& cls);
+
   void init(ast::Class* cls);
 
+  // Does the same as the above for a class in a flat tree.
+  void init(const ast::flat::Tree& tree, const ast::flat::Class& cls);
+
   Class* castToClass() override;
 
 protected:
 
-  std::string name;
+  support::InternedString name;
 
 };
 
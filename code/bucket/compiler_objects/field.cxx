@@ -3,7 +3,7 @@
 using namespace cobjs;
 
 
-Field::Field(Scope* parent, const std::string& name, Class* cls)
+Field::Field(Scope* parent, support::InternedString name, Class* cls)
 : Object(parent),
   name(name),
   cls(cls)
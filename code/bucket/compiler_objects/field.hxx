@@ -1,7 +1,7 @@
 #pragma once
 #include "common.hxx"
 #include "compiler_objects/object.hxx"
-#include <string>
+#include "support/stringinterner.hxx"
 
 
 namespace cobjs {
@@ -14,11 +14,11 @@ class Field : public Object {
 
 public:
 
-  Field(Scope* parent, const std::string& name, Class* cls);
+  Field(Scope* parent, support::InternedString name, Class* cls);
 
 protected:
 
-  const std::string name;
+  const support::InternedString name;
 
   Class* const cls;
 
@@ -4,7 +4,7 @@
 using namespace cobjs;
 
 
-Method::Method(Scope* parent_scope, const std::string& name, std::vector<Class*>&& argument_classes, Class* return_type)
+Method::Method(Scope* parent_scope, support::InternedString name, std::vector<Class*>&& argument_classes, Class* return_type)
 : Object(parent_scope),
   name(name),
   argument_classes(std::move(argument_classes)),
@@ -1,7 +1,7 @@
 #pragma once
 #include "common.hxx"
 #include "compiler_objects/object.hxx"
-#include <string>
+#include "support/stringinterner.hxx"
 #include <vector>
 
 
@@ -15,11 +15,11 @@ class Method : public Object {
 
 public:
 
-  Method(Scope* parent_scope, const std::string& name, std::vector<Class*>&& argument_classes, Class* return_type);
+  Method(Scope* parent_scope, support::InternedString name, std::vector<Class*>&& argument_classes, Class* return_type);
 
 protected:
 
-  const std::string name;
+  const support::InternedString name;
 
   std::vector<Class*> argument_classes;
 
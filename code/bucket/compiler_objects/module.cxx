@@ -1,5 +1,6 @@
 #include "common.hxx"
 #include "compiler_objects/module.hxx"
+#include "abstract_syntax_tree/flat_tree.hxx"
 using namespace cobjs;
 
 
@@ -8,6 +9,11 @@ Module::Module(ast::Class* cls)
 {}
 
 
+Module::Module(const ast::flat::Tree& tree)
+: Class(nullptr, tree.get<ast::flat::Class>(tree.root()))
+{}
+
+
 Object* Module::addToModuleFreeList(std::unique_ptr<Object>&& object)
 {
   auto ptr = object.get();
@@ -16,7 +22,7 @@ Object* Module::addToModuleFreeList(std::unique_ptr<Object>&& object)
 }
 
 
-Object* Module::lookup(const std::string& name)
+Object* Module::lookup(support::InternedString name)
 {
   auto iter = map.find(name);
   if (iter != map.end())
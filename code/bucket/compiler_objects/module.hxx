@@ -14,7 +14,10 @@ public:
 
   Module(ast::Class* cls);
 
-  Object* lookup(const std::string& name) override;
+  // The module of the program in 'tree'.
+  explicit Module(const ast::flat::Tree& tree);
+
+  Object* lookup(support::InternedString name) override;
 
 protected:
 
@@ -2,6 +2,7 @@
 #include "compiler_objects/scope.hxx"
 #include "abstract_syntax_tree/abstract_syntax_tree.hxx"
 #include "abstract_syntax_tree/caster.hxx"
+#include "abstract_syntax_tree/flat_tree.hxx"
 #include <stdexcept>
   #include <iostream>
 using namespace cobjs;
@@ -12,7 +13,7 @@ Scope::Scope(Scope* parent_scope) noexcept
 {}
 
 
-Object* Scope::lookup(const std::string& name)
+Object* Scope::lookup(support::InternedString name)
 {
   auto iter = map.find(name);
   if (iter != map.end())
@@ -23,8 +24,23 @@ Object* Scope::lookup(const std::string& name)
 
 Class* Scope::lookupClass(ast::Expression* expression)
 {
-  if (auto identifier = ast::ast_cast<ast::Identifier*>(expression)) {
-    auto object = lookup(identifier->value);
+  if (expression && ast::isa<ast::Identifier>(expression)) {
+    auto object = lookup(ast::cast<ast::Identifier>(expression)->value);
+    if (!object)
+      throw std::runtime_error("undefined identifier");
+    auto result = object->castToClass();
+    if (!result)
+      throw std::runtime_error("not a class");
+    return result;
+  }
+  throw std::runtime_error("TODO");
+}
+
+
+Class* Scope::lookupClass(const ast::flat::Tree& tree, ast::flat::NodeId expression)
+{
+  if (expression.kind() == ast::NodeKind::Identifier) {
+    auto object = lookup(tree.get<ast::flat::Identifier>(expression).value);
     if (!object)
       throw std::runtime_error("undefined identifier");
     auto result = object->castToClass();
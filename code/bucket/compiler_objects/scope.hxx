@@ -1,7 +1,7 @@
 #pragma once
 #include "common.hxx"
 #include "compiler_objects/object.hxx"
-#include <string>
+#include "support/stringinterner.hxx"
 #include <unordered_map>
 
 
@@ -14,6 +14,16 @@ struct Expression;
 }
 
 
+namespace ast::flat {
+
+
+class NodeId;
+class Tree;
+
+
+}
+
+
 namespace cobjs {
 
 
@@ -26,13 +36,15 @@ public:
 
   explicit Scope(Scope* parent_scope) noexcept;
 
-  virtual Object* lookup(const std::string& name);
+  virtual Object* lookup(support::InternedString name);
 
   Class* lookupClass(ast::Expression* expression);
 
+  Class* lookupClass(const ast::flat::Tree& tree, ast::flat::NodeId expression);
+
 protected:
 
-  std::unordered_map<std::string, Object*> map;
+  std::unordered_map<support::InternedString, Object*> map;
 
 };
 
@@ -1,16 +1,316 @@
 #include "common.hxx"
 #include "frontend/lexer.hxx"
+#include "support/bytescan.hxx"
+#include "support/characterclass.hxx"
 #include "support/concatenate.hxx"
+#include "support/utf8.hxx"
+#include <array>
+#include <charconv>
 #include <cassert>
-#include <cctype>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <initializer_list>
 #include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
 
 namespace frontend {
 
-Lexer::Lexer(const char* path)
-: mSourceFile(path)
+namespace {
+
+// Every byte of the input belongs to one of these classes; the transition
+// table is indexed by class rather than by byte.
+enum ByteClass : unsigned char {
+  Other,        // bytes that cannot start a token
+  Space,        // '\t', '\v', '\f' and ' '
+  Newline,
+  Letter,       // ASCII letters other than 'e' and 'E', and '_'
+  ExponentMark, // 'e' and 'E'
+  Digit,
+  Period,
+  Slash,
+  Star,
+  Bang,
+  Equals,
+  Less,
+  Greater,
+  PlusOrMinus,
+  DoubleQuote,
+  SingleQuote,
+  Punctuation,  // the remaining single-character symbols
+  NonAscii,     // any byte of a multi-byte sequence
+  EndOfInput,   // not a byte; seen once the whole file has been scanned
+  BYTE_CLASS_COUNT
+};
+
+constexpr std::array<ByteClass, 256> byteClasses = [] {
+  std::array<ByteClass, 256> table{};
+  for (int c = 'a'; c <= 'z'; ++c)
+    table[c] = Letter;
+  for (int c = 'A'; c <= 'Z'; ++c)
+    table[c] = Letter;
+  table['_'] = Letter;
+  table['e'] = table['E'] = ExponentMark;
+  for (int c = '0'; c <= '9'; ++c)
+    table[c] = Digit;
+  table['\t'] = table['\v'] = table['\f'] = table[' '] = Space;
+  table['\n'] = Newline;
+  table['.'] = Period;
+  table['/'] = Slash;
+  table['*'] = Star;
+  table['!'] = Bang;
+  table['='] = Equals;
+  table['<'] = Less;
+  table['>'] = Greater;
+  table['+'] = table['-'] = PlusOrMinus;
+  table['"'] = DoubleQuote;
+  table['\''] = SingleQuote;
+  for (unsigned char c : {'%', '&', '(', ')', ',', ':', '[', '\\', ']', '^'})
+    table[c] = Punctuation;
+  for (int c = 0x80; c <= 0xFF; ++c)
+    table[c] = NonAscii;
+  return table;
+}();
+
+// the symbols that are a single byte, indexed by that byte
+constexpr std::array<Symbol, 128> singleByteSymbols = [] {
+  std::array<Symbol, 128> table{};
+  table['\n'] = Symbol::Newline;
+  table['%'] = Symbol::PercentSign;
+  table['&'] = Symbol::Ampersand;
+  table['('] = Symbol::OpenParenthesis;
+  table[')'] = Symbol::CloseParenthesis;
+  table['*'] = Symbol::Asterisk;
+  table['+'] = Symbol::Plus;
+  table[','] = Symbol::Comma;
+  table['-'] = Symbol::Minus;
+  table[':'] = Symbol::Colon;
+  table['['] = Symbol::OpenSquareBracket;
+  table['\\'] = Symbol::CloseSquareBracket;
+  table[']'] = Symbol::CloseSquareBracket;
+  table['^'] = Symbol::Caret;
+  return table;
+}();
+
+// A transition either moves the scanner to another state, consuming the
+// current byte, or stops it at the current byte with an action that decides
+// what to do next.
+enum Transition : unsigned char {
+
+  // states
+  Start, Identifier, Integer, Fraction, PeriodSeen, ExponentStart,
+  ExponentSign, Exponent, SlashSeen, BangSeen, EqualsSeen, LessSeen,
+  GreaterSeen,
+  STATE_COUNT,
+
+  // actions
+  SkipBlanks = STATE_COUNT, LineComment, BlockComment, EmitEndOfFile, EmitSymbol,
+  EmitIdentifier, NonAsciiStart, NonAsciiIdentifier, EmitInteger,
+  IntegerLetter, IntegerNonAscii, EmitReal, RealLetter, RealNonAscii,
+  ExponentError, EmitPeriod, EmitSlash, BangError, EmitBangEquals,
+  EmitSingleEquals, EmitDoubleEquals, EmitLesser, EmitLesserOrEqual,
+  EmitGreater, EmitGreaterOrEqual, StringLiteral, CharacterLiteral,
+  UnexpectedCharacter
+
+};
+
+// the states whose text is part of the token they produce
+constexpr bool keepsText(Transition state) noexcept
 {
+  return Identifier <= state && state <= Exponent;
+}
+
+constexpr auto transitions = [] {
+  std::array<std::array<Transition, BYTE_CLASS_COUNT>, STATE_COUNT> table{};
+  auto otherwise = [&table](Transition state, Transition transition) {
+    for (auto& entry : table[state])
+      entry = transition;
+  };
+  auto on = [&table](Transition state, std::initializer_list<ByteClass> byte_classes, Transition transition) {
+    for (auto byte_class : byte_classes)
+      table[state][byte_class] = transition;
+  };
+
+  otherwise(Start, UnexpectedCharacter);
+  on(Start, {Space}, SkipBlanks);
+  on(Start, {Newline, Star, PlusOrMinus, Punctuation}, EmitSymbol);
+  on(Start, {Letter, ExponentMark}, Identifier);
+  on(Start, {Digit}, Integer);
+  on(Start, {Period}, PeriodSeen);
+  on(Start, {Slash}, SlashSeen);
+  on(Start, {Bang}, BangSeen);
+  on(Start, {Equals}, EqualsSeen);
+  on(Start, {Less}, LessSeen);
+  on(Start, {Greater}, GreaterSeen);
+  on(Start, {DoubleQuote}, StringLiteral);
+  on(Start, {SingleQuote}, CharacterLiteral);
+  on(Start, {NonAscii}, NonAsciiStart);
+  on(Start, {EndOfInput}, EmitEndOfFile);
+
+  otherwise(Identifier, EmitIdentifier);
+  on(Identifier, {Letter, ExponentMark, Digit}, Identifier);
+  on(Identifier, {NonAscii}, NonAsciiIdentifier);
+
+  otherwise(Integer, EmitInteger);
+  on(Integer, {Digit}, Integer);
+  on(Integer, {Period}, Fraction);
+  on(Integer, {ExponentMark}, ExponentStart);
+  on(Integer, {Letter}, IntegerLetter);
+  on(Integer, {NonAscii}, IntegerNonAscii);
+
+  otherwise(Fraction, EmitReal);
+  on(Fraction, {Digit}, Fraction);
+  on(Fraction, {ExponentMark}, ExponentStart);
+  on(Fraction, {Letter}, RealLetter);
+  on(Fraction, {NonAscii}, RealNonAscii);
+
+  otherwise(PeriodSeen, EmitPeriod);
+  on(PeriodSeen, {Digit}, Fraction);
+
+  otherwise(ExponentStart, ExponentError);
+  on(ExponentStart, {PlusOrMinus}, ExponentSign);
+  on(ExponentStart, {Digit}, Exponent);
+
+  otherwise(ExponentSign, ExponentError);
+  on(ExponentSign, {Digit}, Exponent);
+
+  otherwise(Exponent, EmitReal);
+  on(Exponent, {Digit}, Exponent);
+  on(Exponent, {Letter, ExponentMark}, RealLetter);
+  on(Exponent, {NonAscii}, RealNonAscii);
+
+  otherwise(SlashSeen, EmitSlash);
+  on(SlashSeen, {Slash}, LineComment);
+  on(SlashSeen, {Star}, BlockComment);
+
+  otherwise(BangSeen, BangError);
+  on(BangSeen, {Equals}, EmitBangEquals);
+
+  otherwise(EqualsSeen, EmitSingleEquals);
+  on(EqualsSeen, {Equals}, EmitDoubleEquals);
+
+  otherwise(LessSeen, EmitLesser);
+  on(LessSeen, {Equals}, EmitLesserOrEqual);
+
+  otherwise(GreaterSeen, EmitGreater);
+  on(GreaterSeen, {Equals}, EmitGreaterOrEqual);
+
+  return table;
+}();
+
+// The keywords and the boolean literals are found with a perfect hash of
+// their first and last bytes and their length. Words that hash to a slot are
+// still compared in full, so identifiers never need more than one compare.
+struct ReservedWord {
+  std::string_view spelling;
+  bool isBooleanLiteral;
+  Keyword keyword;
+  bool booleanLiteral;
+};
+
+constexpr ReservedWord keyword(std::string_view spelling, Keyword keyword) noexcept
+{
+  return {spelling, false, keyword, false};
+}
+
+constexpr ReservedWord booleanLiteral(std::string_view spelling, bool value) noexcept
+{
+  return {spelling, true, Keyword(), value};
+}
+
+constexpr ReservedWord reservedWordList[] = {
+  keyword("end", Keyword::End),
+  keyword("if", Keyword::If),
+  keyword("elif", Keyword::Elif),
+  keyword("else", Keyword::Else),
+  keyword("do", Keyword::Do),
+  keyword("for", Keyword::For),
+  keyword("break", Keyword::Break),
+  keyword("cycle", Keyword::Cycle),
+  keyword("ret", Keyword::Ret),
+  keyword("and", Keyword::And),
+  keyword("or", Keyword::Or),
+  keyword("not", Keyword::Not),
+  keyword("class", Keyword::Class),
+  keyword("method", Keyword::Method),
+  booleanLiteral("true", true),
+  booleanLiteral("false", false)
+};
+
+constexpr std::size_t RESERVED_WORD_SLOTS = 32;
+
+constexpr std::size_t MAX_RESERVED_WORD_LENGTH = 6;
+
+constexpr std::size_t reservedWordHash(std::string_view word) noexcept
+{
+  auto first = static_cast<unsigned char>(word.front());
+  auto last = static_cast<unsigned char>(word.back());
+  return ((first + last) * 4 + word.size()) % RESERVED_WORD_SLOTS;
+}
+
+constexpr auto reservedWords = [] {
+  std::array<ReservedWord, RESERVED_WORD_SLOTS> table{};
+  for (auto& reserved_word : reservedWordList)
+    table[reservedWordHash(reserved_word.spelling)] = reserved_word;
+  return table;
+}();
+
+constexpr bool isPerfect() noexcept
+{
+  for (auto& reserved_word : reservedWordList) {
+    if (reserved_word.spelling.size() > MAX_RESERVED_WORD_LENGTH)
+      return false;
+    if (reservedWords[reservedWordHash(reserved_word.spelling)].spelling != reserved_word.spelling)
+      return false;
+  }
+  return true;
+}
+
+static_assert(isPerfect(), "two reserved words have the same hash");
+
+const ReservedWord* findReservedWord(std::string_view word) noexcept
+{
+  if (word.empty() || word.size() > MAX_RESERVED_WORD_LENGTH)
+    return nullptr;
+  auto& reserved_word = reservedWords[reservedWordHash(word)];
+  if (reserved_word.spelling != word)
+    return nullptr;
+  return &reserved_word;
+}
+
+bool startsIdentifier(const unsigned char* bytes) noexcept
+{
+  std::int32_t code_point;
+  support::decodeValidUtf8(bytes, code_point);
+  return support::characterClasses(code_point) & support::IdentifierStart;
+}
+
+}
+
+Lexer::Lexer(SourceManager& source_manager, SourceManager::FileId file)
+: mSourceFile(source_manager, file),
+  mSharesFile(false)
+{
+  auto chunk = mSourceFile.chunk();
+  mCursor = mChunkBegin = reinterpret_cast<const unsigned char*>(chunk.data());
+  mEnd = mCursor + chunk.size();
+  mChunkLocation = mSourceFile.location();
+  next();
+}
+
+Lexer::Lexer(SourceManager& source_manager, SourceManager::FileId file, SourceLocation start)
+: mSourceFile(source_manager, file),
+  mSharesFile(true)
+{
+  assert(!mSourceFile.isStreamed());
+  auto chunk = mSourceFile.chunk();
+  mChunkBegin = reinterpret_cast<const unsigned char*>(chunk.data());
+  mEnd = mChunkBegin + chunk.size();
+  mChunkLocation = mSourceFile.location();
+  assert(mChunkLocation.offset() <= start.offset() && start.offset() <= mChunkLocation.offset() + chunk.size());
+  mCursor = mChunkBegin + (start.offset() - mChunkLocation.offset());
   next();
 }
 
@@ -19,434 +319,465 @@ Token& Lexer::currentToken()
   return mCurrentToken;
 }
 
+const LiteralTable& Lexer::literals() const noexcept
+{
+  return mLiterals;
+}
+
+LiteralTable Lexer::takeLiterals() noexcept
+{
+  return std::move(mLiterals);
+}
+
 void Lexer::next()
 {
-  if (mSourceFile.currentCharacter().isEndOfFile()) {
-    lexSymbol(Symbol::EndOfFile);
-    return;
-  }
+  auto p = mCursor;
+  auto token_start = p;
+  auto state = Start;
+  while (true) {
+
+    // run the tables until they call for an action
+    Transition transition;
+    while (true) {
+      if (p == mEnd) {
+        mCursor = p;
+        if (state != Start)
+          carry(token_start, keepsText(state));
+        refill();
+        p = token_start = mCursor;
+      }
+      auto byte_class = p != mEnd ? byteClasses[*p] : EndOfInput;
+      transition = transitions[state][byte_class];
+      if (transition >= STATE_COUNT)
+        break;
+      state = transition;
+      ++p;
+    }
 
-  if (mSourceFile.currentCharacter().isLetter() || mSourceFile.currentCharacter() == '_') {
-    lexIdentifierOrKeyword();
-    return;
-  }
+    mCursor = p;
+    switch (transition) {
+
+      case SkipBlanks:
+        // a single blank between tokens is the usual case, and not worth
+        // setting up a vector scan for
+        ++p;
+        if (p != mEnd && byteClasses[*p] == Space)
+          p = support::skipBlanks(p + 1, mEnd);
+        token_start = p;
+        continue;
+
+      case LineComment:
+        mCarriedBegin = SourceLocation();
+        skipLineComment();
+        p = token_start = mCursor;
+        state = Start;
+        continue;
+
+      case BlockComment:
+        mCarriedBegin = SourceLocation();
+        skipBlockComment();
+        p = token_start = mCursor;
+        state = Start;
+        continue;
+
+      case EmitEndOfFile:
+        mCurrentToken = Token::symbol(tokenBegin(token_start), location(p), Symbol::EndOfFile);
+        return;
+
+      case EmitSymbol:
+        {
+          auto begin = tokenBegin(token_start);
+          auto symbol = singleByteSymbols[*mCursor++];
+          mCurrentToken = Token::symbol(begin, location(mCursor), symbol);
+          return;
+        }
 
-  auto ascii = mSourceFile.currentCharacter().getAscii();
+      case EmitIdentifier:
+        {
+          auto begin = tokenBegin(token_start);
+          if (mCarriedText.empty())
+            makeIdentifierOrKeyword(begin, std::string_view(reinterpret_cast<const char*>(token_start), p - token_start));
+          else
+            makeIdentifierOrKeyword(begin, tokenText(token_start, p));
+          return;
+        }
 
-  if (ascii == -1)
-    throw std::runtime_error("unknown unicode character");
+      case NonAsciiStart:
+        if (!startsIdentifier(p))
+          throw std::runtime_error("unknown unicode character");
+        [[fallthrough]];
+      case NonAsciiIdentifier:
+        lexNonAsciiIdentifier(tokenBegin(token_start), token_start);
+        return;
+
+      case IntegerNonAscii:
+        if (!startsIdentifier(p)) {
+          lexIntegerLiteral(token_start);
+          return;
+        }
+        [[fallthrough]];
+      case IntegerLetter:
+        throw std::runtime_error("letter in number literal");
 
-  switch (ascii) {
+      case EmitInteger:
+        lexIntegerLiteral(token_start);
+        return;
 
-    case '\n':
-      lexSymbol(Symbol::Newline);
-      break;
+      case RealNonAscii:
+        if (!startsIdentifier(p)) {
+          lexRealLiteral(token_start);
+          return;
+        }
+        [[fallthrough]];
+      case RealLetter:
+        throw std::runtime_error(support::concatenate("letter in number literal (line ", positionAt(p).line, ", column ", positionAt(p).column, ')'));
 
-    case '\t':
-    case '\v':
-    case '\f':
-    case ' ':
-      mSourceFile.next();
-      next();
-      break;
+      case EmitReal:
+        lexRealLiteral(token_start);
+        return;
 
-    case '!':
-      {
-        auto begin = mSourceFile.position();
-        mSourceFile.next();
-        if (mSourceFile.currentCharacter() != '=')
-          throw std::runtime_error(support::concatenate("expected \'=\' after \'!\' (line ", mSourceFile.position().line, ", column ", mSourceFile.position().column, ')'));
-        mCurrentToken = Token::symbol(begin, mSourceFile.position(), Symbol::BangEquals);
-        mSourceFile.next();
-        break;
-      }
+      case ExponentError:
+        throw std::runtime_error(support::concatenate("expected number in real literal exponent (", positionAt(p).line, ", column ", positionAt(p).column, ')'));
 
-    case '"':
-      lexStringLiteral();
-      break;
+      case EmitPeriod:
+        // the period was kept in case a fraction followed it; if the chunk
+        // ended after it, drop the copy so that it does not start the next
+        // token
+        mCarriedText.clear();
+        mCurrentToken = Token::symbol(tokenBegin(token_start), location(p), Symbol::Period);
+        return;
 
-    case '%':
-      lexSymbol(Symbol::PercentSign);
-      break;
+      case EmitSlash:
+        mCurrentToken = Token::symbol(tokenBegin(token_start), location(p), Symbol::Slash);
+        return;
 
-    case '&':
-      lexSymbol(Symbol::Ampersand);
-      break;
+      case BangError:
+        throw std::runtime_error(support::concatenate("expected \'=\' after \'!\' (line ", positionAt(p).line, ", column ", positionAt(p).column, ')'));
 
-    case '\'':
-      lexCharacterLiteral();
-      break;
+      case EmitBangEquals:
+        // the token has always ended before the '='
+        mCurrentToken = Token::symbol(tokenBegin(token_start), location(mCursor++), Symbol::BangEquals);
+        return;
 
-    case '(':
-      lexSymbol(Symbol::OpenParenthesis);
-      break;
+      case EmitSingleEquals:
+        mCurrentToken = Token::symbol(tokenBegin(token_start), location(p), Symbol::SingleEquals);
+        return;
 
-    case ')':
-      lexSymbol(Symbol::CloseParenthesis);
-      break;
+      case EmitDoubleEquals:
+        mCurrentToken = Token::symbol(tokenBegin(token_start), location(++mCursor), Symbol::DoubleEquals);
+        return;
 
-    case '*':
-      lexSymbol(Symbol::Asterisk);
-      break;
+      case EmitLesser:
+        mCurrentToken = Token::symbol(tokenBegin(token_start), location(p), Symbol::Lesser);
+        return;
 
-    case '+':
-      lexSymbol(Symbol::Plus);
-      break;
+      case EmitLesserOrEqual:
+        mCurrentToken = Token::symbol(tokenBegin(token_start), location(++mCursor), Symbol::LesserOrEqual);
+        return;
 
-    case ',':
-      lexSymbol(Symbol::Comma);
-      break;
+      case EmitGreater:
+        mCurrentToken = Token::symbol(tokenBegin(token_start), location(p), Symbol::Greater);
+        return;
 
-    case '-':
-      lexSymbol(Symbol::Minus);
-      break;
+      case EmitGreaterOrEqual:
+        mCurrentToken = Token::symbol(tokenBegin(token_start), location(++mCursor), Symbol::GreaterOrEqual);
+        return;
 
-    case '.':
-    case '0':
-    case '1':
-    case '2':
-    case '3':
-    case '4':
-    case '5':
-    case '6':
-    case '7':
-    case '8':
-    case '9':
-      lexNumberOrPeriod();
-      break;
+      case StringLiteral:
+        lexStringLiteral(tokenBegin(token_start));
+        return;
 
-    case '/':
-      lexSlash();
-      break;
+      case CharacterLiteral:
+        lexCharacterLiteral(tokenBegin(token_start));
+        return;
 
-    case ':':
-      lexSymbol(Symbol::Colon);
-      break;
+      case UnexpectedCharacter:
+        throw std::runtime_error(support::concatenate("unexpected character"));
 
-    case '<':
-      {
-        Symbol symbol;
-        auto begin = mSourceFile.position();
-        mSourceFile.next();
-        if (mSourceFile.currentCharacter() == '=') {
-          symbol = Symbol::LesserOrEqual;
-          mSourceFile.next();
-        }
-        else
-          symbol = Symbol::Lesser;
-        mCurrentToken = Token::symbol(begin, mSourceFile.position(), symbol);
-        break;
-      }
-    case '=':
-      {
-        Symbol symbol;
-        auto begin = mSourceFile.position();
-        mSourceFile.next();
-        if (mSourceFile.currentCharacter() == '=') {
-          symbol = Symbol::DoubleEquals;
-          mSourceFile.next();
-        }
-        else
-          symbol = Symbol::SingleEquals;
-        mCurrentToken = Token::symbol(begin, mSourceFile.position(), symbol);
-        break;
-      }
-    case '>':
-      {
-        Symbol symbol;
-        auto begin = mSourceFile.position();
-        mSourceFile.next();
-        if (mSourceFile.currentCharacter() == '=') {
-          symbol = Symbol::GreaterOrEqual;
-          mSourceFile.next();
-        }
-        else
-          symbol = Symbol::Greater;
-        mCurrentToken = Token::symbol(begin, mSourceFile.position(), symbol);
-        break;
-      }
+      default:
+        assert(false);
+        return;
 
-    case '[':
-      lexSymbol(Symbol::OpenSquareBracket);
-      break;
+    }
+  }
+}
 
-    case '\\':
-    case ']':
-      lexSymbol(Symbol::CloseSquareBracket);
-      break;
+SourcePosition Lexer::position(SourceLocation location) const noexcept
+{
+  return mSourceFile.position(location);
+}
 
-    case '^':
-      lexSymbol(Symbol::Caret);
-      break;
+void Lexer::refill()
+{
+  // the whole of a file that is not streamed is in memory, so there is
+  // nothing to read
+  if (mSharesFile)
+    return;
+  mSourceFile.skipChunk();
+  auto chunk = mSourceFile.chunk();
+  mCursor = mChunkBegin = reinterpret_cast<const unsigned char*>(chunk.data());
+  mEnd = mCursor + chunk.size();
+  mChunkLocation = mSourceFile.location();
+}
 
-    default:
-      throw std::runtime_error(support::concatenate("unexpected character"));
+void Lexer::carry(const unsigned char* token_start, bool keep_text)
+{
+  if (!mCarriedBegin.isValid())
+    mCarriedBegin = location(token_start);
+  if (keep_text)
+    mCarriedText.append(token_start, mCursor);
+}
 
-  }
+SourceLocation Lexer::location(const unsigned char* position) const noexcept
+{
+  return SourceLocation(mChunkLocation.offset() + static_cast<std::uint32_t>(position - mChunkBegin));
 }
 
-void Lexer::lexSymbol(Symbol symbol)
-{
-  auto begin = mSourceFile.position();
-  mSourceFile.next();
-  mCurrentToken = Token::symbol(begin, mSourceFile.position(), symbol);
-}
-
-void Lexer::lexStringLiteral()
-{
-  auto begin = mSourceFile.position();
-  assert(mSourceFile.currentCharacter() == '"');
-  mSourceFile.next();
-  std::string s;
-  while (mSourceFile.currentCharacter() != '"') {
-    if (mSourceFile.currentCharacter().isEndOfFile())
-      throw std::runtime_error(support::concatenate("string literal starting on line ", mSourceFile.position().line, ", column ", mSourceFile.position().column, " not closed"));
-    support::UnicodeCharacter character;
-    if (mSourceFile.currentCharacter() == '\\') {
-      mSourceFile.next();
-      auto ascii = mSourceFile.currentCharacter().getAscii();
-      if (ascii == -1)
-        throw std::runtime_error("invalid escape sequence");
-      switch (ascii) {
-        case 'a':
-          character = '\a';
-          break;
-        case 'b':
-          character = '\b';
-          break;
-        case 'f':
-          character = '\f';
-          break;
-        case 'n':
-          character = '\n';
-          break;
-        case 'r':
-          character = '\r';
-          break;
-        case 't':
-          character = '\t';
-          break;
-        case 'v':
-          character = '\v';
-          break;
-        case '\\':
-          character = '\\';
-          break;
-        case '\'':
-          character = '\'';
-          break;
-        case '"':
-          character = '"';
-          break;
-        default:
-          throw std::runtime_error(support::concatenate("invalid escape sequence (line ", mSourceFile.position().line, ", column ", mSourceFile.position().column - 1, ")"));
-      }
-    }
-    else
-      character = mSourceFile.currentCharacter();
-    s += character;
-    mSourceFile.next();
+SourcePosition Lexer::positionAt(const unsigned char* position) const noexcept
+{
+  return mSourceFile.position(location(position));
+}
+
+SourceLocation Lexer::tokenBegin(const unsigned char* token_start) noexcept
+{
+  if (!mCarriedBegin.isValid())
+    return location(token_start);
+  return std::exchange(mCarriedBegin, SourceLocation());
+}
+
+std::string Lexer::tokenText(const unsigned char* token_start, const unsigned char* token_end)
+{
+  if (mCarriedText.empty())
+    return std::string(token_start, token_end);
+  auto text = std::move(mCarriedText);
+  mCarriedText.clear();
+  text.append(token_start, token_end);
+  return text;
+}
+
+bool Lexer::atEndOfFile()
+{
+  if (mCursor == mEnd)
+    refill();
+  return mCursor == mEnd;
+}
+
+void Lexer::advanceCodePoint()
+{
+  if (atEndOfFile())
+    return;
+  std::int32_t code_point;
+  mCursor += support::decodeValidUtf8(mCursor, code_point);
+}
+
+support::UnicodeCharacter Lexer::lexEscapedCharacter()
+{
+  if (atEndOfFile() || *mCursor > 0x7F)
+    throw std::runtime_error("invalid escape sequence");
+  switch (*mCursor) {
+    case 'a':
+      return '\a';
+    case 'b':
+      return '\b';
+    case 'f':
+      return '\f';
+    case 'n':
+      return '\n';
+    case 'r':
+      return '\r';
+    case 't':
+      return '\t';
+    case 'v':
+      return '\v';
+    case '\\':
+      return '\\';
+    case '\'':
+      return '\'';
+    case '"':
+      return '"';
+    default:
+      throw std::runtime_error(support::concatenate("invalid escape sequence (line ", positionAt(mCursor).line, ", column ", positionAt(mCursor).column - 1, ")"));
   }
-  mSourceFile.next();
-  mCurrentToken = Token::stringLiteral(begin, mSourceFile.position(), move(s));
 }
 
-void Lexer::lexCharacterLiteral()
+void Lexer::lexStringLiteral(SourceLocation begin)
 {
-  auto begin = mSourceFile.position();
-  assert(mSourceFile.currentCharacter() == '\'');
-  mSourceFile.next();
-  support::UnicodeCharacter character;
-  if (mSourceFile.currentCharacter() == '\'')
-    throw std::runtime_error(support::concatenate("empty character literal (", mSourceFile.position().line, ", column ", mSourceFile.position().column, ")"));
-  if (mSourceFile.currentCharacter() == '\\') {
-    mSourceFile.next();
-    auto ascii = mSourceFile.currentCharacter().getAscii();
-    if (ascii == -1)
-      throw std::runtime_error("invalid escape sequence");
-    switch (ascii) {
-      case 'a':
-        character = '\a';
-        break;
-      case 'b':
-        character = '\b';
-        break;
-      case 'f':
-        character = '\f';
-        break;
-      case 'n':
-        character = '\n';
-        break;
-      case 'r':
-        character = '\r';
-        break;
-      case 't':
-        character = '\t';
-        break;
-      case 'v':
-        character = '\v';
-        break;
-      case '\\':
-        character = '\\';
-        break;
-      case '\'':
-        character = '\'';
-        break;
-      case '"':
-        character = '"';
-        break;
-      default:
-        throw std::runtime_error(support::concatenate("invalid escape sequence (line ", mSourceFile.position().line, ", column ", mSourceFile.position().column - 1, ")"));
-    }
+  assert(*mCursor == '"');
+  ++mCursor;
+  auto text_start = mCursor;
+  while (mCursor != mEnd && *mCursor != '"' && *mCursor != '\\')
+    ++mCursor;
+
+  // a literal without escape sequences is a view of the file itself, unless
+  // the file is streamed and the bytes are about to be overwritten
+  if (mCursor != mEnd && *mCursor == '"' && !mSourceFile.isStreamed()) {
+    std::string_view text(reinterpret_cast<const char*>(text_start), mCursor - text_start);
+    ++mCursor;
+    mCurrentToken = Token::stringLiteral(begin, location(mCursor), mLiterals.addString(text));
+    return;
   }
-  else
-    character = mSourceFile.currentCharacter();
-  mSourceFile.next();
-  if (mSourceFile.currentCharacter() != '\'')
-    throw std::runtime_error(support::concatenate("character literal has multiple characters (line ", mSourceFile.position().line, ", column ", mSourceFile.position().column, ")"));
-  mSourceFile.next();
-  mCurrentToken = Token::characterLiteral(begin, mSourceFile.position(), character);
-}
-
-void Lexer::lexNumberOrPeriod()
-{
-  auto begin = mSourceFile.position();
-  std::string number;
-  if (mSourceFile.currentCharacter() == '.') {
-    mSourceFile.next();
-    if (!mSourceFile.currentCharacter().isAsciiDigit()) {
-      mCurrentToken = Token::symbol(begin, mSourceFile.position(), Symbol::Period);
-      return;
+
+  // otherwise it is decoded into text owned by the source manager
+  std::string s(text_start, mCursor);
+  while (true) {
+    if (atEndOfFile())
+      throw std::runtime_error(support::concatenate("string literal starting on line ", positionAt(mCursor).line, ", column ", positionAt(mCursor).column, " not closed"));
+    if (*mCursor == '"')
+      break;
+    if (*mCursor == '\\') {
+      ++mCursor;
+      s += lexEscapedCharacter();
+      ++mCursor;
     }
-    number += '.';
-    do {
-      number += mSourceFile.currentCharacter();
-      mSourceFile.next();
-    } while (mSourceFile.currentCharacter().isAsciiDigit());
+    // copy everything up to the next quote or backslash at once
+    auto run_start = mCursor;
+    while (mCursor != mEnd && *mCursor != '"' && *mCursor != '\\')
+      ++mCursor;
+    s.append(run_start, mCursor);
   }
-  else {
-    do {
-      number += mSourceFile.currentCharacter();
-      mSourceFile.next();
-    } while (mSourceFile.currentCharacter().isAsciiDigit());
-    if (mSourceFile.currentCharacter() == '.') {
-      do {
-        number += mSourceFile.currentCharacter();
-        mSourceFile.next();
-      } while (mSourceFile.currentCharacter().isAsciiDigit());
-      mCurrentToken = Token();
+  ++mCursor;
+  mCurrentToken = Token::stringLiteral(begin, location(mCursor), mLiterals.addString(mSourceFile.storeText(s)));
+}
+
+void Lexer::lexCharacterLiteral(SourceLocation begin)
+{
+  assert(*mCursor == '\'');
+  ++mCursor;
+  support::UnicodeCharacter character;
+  if (!atEndOfFile()) {
+    if (*mCursor == '\'')
+      throw std::runtime_error(support::concatenate("empty character literal (", positionAt(mCursor).line, ", column ", positionAt(mCursor).column, ")"));
+    if (*mCursor == '\\') {
+      ++mCursor;
+      character = lexEscapedCharacter();
+      ++mCursor;
     }
-    else if (mSourceFile.currentCharacter() != 'e' && mSourceFile.currentCharacter() != 'E') {
-      if (mSourceFile.currentCharacter().isLetter() || mSourceFile.currentCharacter() == '_')
-        throw std::runtime_error("letter in number literal");
-      mCurrentToken = Token::integerLiteral(begin, mSourceFile.position(), std::stoul(number));
-      return;
+    else {
+      character = support::UnicodeCharacter::fromValidUtf8(mCursor);
+      mCursor += character.bytes().size();
     }
   }
-  if (mSourceFile.currentCharacter() == 'e' || mSourceFile.currentCharacter() == 'E') {
-    number += mSourceFile.currentCharacter();
-    mSourceFile.next();
-    if (mSourceFile.currentCharacter() == '+' || mSourceFile.currentCharacter() == '-') {
-      number += mSourceFile.currentCharacter();
-      mSourceFile.next();
+  if (atEndOfFile() || *mCursor != '\'')
+    throw std::runtime_error(support::concatenate("character literal has multiple characters (line ", positionAt(mCursor).line, ", column ", positionAt(mCursor).column, ")"));
+  ++mCursor;
+  mCurrentToken = Token::characterLiteral(begin, location(mCursor), character);
+}
+
+void Lexer::lexIntegerLiteral(const unsigned char* token_start)
+{
+  auto begin = tokenBegin(token_start);
+  unsigned long value;
+  if (!convertNumber(token_start, value))
+    throw std::runtime_error(support::concatenate("integer literal is too large (line ", position(begin).line, ", column ", position(begin).column, ')'));
+  mCurrentToken = Token::integerLiteral(begin, location(mCursor), mLiterals.addInteger(value));
+}
+
+void Lexer::lexRealLiteral(const unsigned char* token_start)
+{
+  auto begin = tokenBegin(token_start);
+  double value;
+  if (!convertNumber(token_start, value))
+    throw std::runtime_error(support::concatenate("real literal is out of range (line ", position(begin).line, ", column ", position(begin).column, ')'));
+  mCurrentToken = Token::realLiteral(begin, location(mCursor), mLiterals.addReal(value));
+}
+
+template <typename Number>
+bool Lexer::convertNumber(const unsigned char* token_start, Number& value)
+{
+  // the tables have already checked the syntax, so only the range can fail
+  auto convert = [&value](const char* first, const char* last) {
+    auto [end, error] = std::from_chars(first, last, value);
+    assert(end == last || error != std::errc());
+    return error == std::errc();
+  };
+  if (mCarriedText.empty())
+    return convert(reinterpret_cast<const char*>(token_start), reinterpret_cast<const char*>(mCursor));
+  auto text = tokenText(token_start, mCursor);
+  return convert(text.data(), text.data() + text.size());
+}
+
+void Lexer::lexNonAsciiIdentifier(SourceLocation begin, const unsigned char* token_start)
+{
+  // the tables have scanned the identifier up to its first non-ASCII code
+  // point; the rest is decoded one code point at a time
+  auto word = tokenText(token_start, mCursor);
+  auto run_start = mCursor;
+  while (true) {
+    if (mCursor == mEnd) {
+      word.append(run_start, mCursor);
+      bool end_of_file = atEndOfFile();
+      run_start = mCursor;
+      if (end_of_file)
+        break;
     }
-    if (!mSourceFile.currentCharacter().isAsciiDigit())
-      throw std::runtime_error(support::concatenate("expected number in real literal exponent (", mSourceFile.position().line, ", column ", mSourceFile.position().column, ')'));
-    do {
-      number += mSourceFile.currentCharacter();
-      mSourceFile.next();
-    } while (mSourceFile.currentCharacter().isAsciiDigit());
+    std::int32_t code_point;
+    auto length = support::decodeValidUtf8(mCursor, code_point);
+    if (!(support::characterClasses(code_point) & support::IdentifierContinue))
+      break;
+    mCursor += length;
   }
-  if (mSourceFile.currentCharacter().isLetter() || mSourceFile.currentCharacter() == '_')
-    throw std::runtime_error(support::concatenate("letter in number literal (line ", mSourceFile.position().line, ", column ", mSourceFile.position().column, ')'));
-  mCurrentToken = Token::realLiteral(begin, mSourceFile.position(), std::stod(number));
+  word.append(run_start, mCursor);
+  // the identifier may end right at the non-ASCII code point, so it can still
+  // be a keyword
+  makeIdentifierOrKeyword(begin, word);
 }
 
-void Lexer::lexSlash()
+void Lexer::skipLineComment()
 {
-  auto begin = mSourceFile.position();
-  mSourceFile.next();
-  if (mSourceFile.currentCharacter() == '/') {
-    do
-      mSourceFile.next();
-    while (mSourceFile.currentCharacter() != '\n' && !mSourceFile.currentCharacter().isEndOfFile());
-    next();
-  }
-  else if (mSourceFile.currentCharacter() == '*') {
-    mSourceFile.next();
-    long long depth = 1;
-    do {
-      mSourceFile.next();
-      if (mSourceFile.currentCharacter().isEndOfFile())
-        throw std::runtime_error(support::concatenate("block comment starting on line ", mSourceFile.position().line, ", column ", mSourceFile.position().column, " not closed"));
-      if (mSourceFile.currentCharacter() == '*') {
-        mSourceFile.next();
-        if (mSourceFile.currentCharacter() == '/')
-          depth--;
-      }
-      else if (mSourceFile.currentCharacter() == '/') {
-        mSourceFile.next();
-        if (mSourceFile.currentCharacter() == '*')
-          depth++;
-      }
-    } while (depth > 0);
-    mSourceFile.next();
-    next();
+  // the newline ends the comment but is left to be lexed as a token
+  while (true) {
+    auto newline = std::memchr(mCursor, '\n', static_cast<std::size_t>(mEnd - mCursor));
+    if (newline) {
+      mCursor = static_cast<const unsigned char*>(newline);
+      return;
+    }
+    mCursor = mEnd;
+    if (atEndOfFile())
+      return;
   }
-  else
-    mCurrentToken = Token::symbol(begin, mSourceFile.position(), Symbol::Slash);
 }
 
-void Lexer::lexIdentifierOrKeyword()
+void Lexer::skipBlockComment()
 {
-  auto begin = mSourceFile.position();
-  std::string word;
+  // Block comments nest. The scan matches the one the lexer has always done:
+  // the character right after the opening "/*" is skipped without being
+  // looked at, and the character after a '*' or '/' is only checked for
+  // completing that delimiter. Everything in between is jumped over by
+  // searching for the next '*' or '/'; neither can be part of a multi-byte
+  // sequence, so the search always stops at the start of a code point.
+  assert(*mCursor == '*');
+  ++mCursor;
+  long long depth = 1;
   do {
-    word += mSourceFile.currentCharacter();
-    mSourceFile.next();
-  } while (mSourceFile.currentCharacter().isNumericDigit() || mSourceFile.currentCharacter().isLetter() || mSourceFile.currentCharacter() == '_');
-  Keyword keyword;
-  if (word == "end")
-    keyword = Keyword::End;
-  else if (word == "if")
-    keyword = Keyword::If;
-  else if (word == "elif")
-    keyword = Keyword::Elif;
-  else if (word == "else")
-    keyword = Keyword::Else;
-  else if (word == "do")
-    keyword = Keyword::Do;
-  else if (word == "for")
-    keyword = Keyword::For;
-  else if (word == "break")
-    keyword = Keyword::Break;
-  else if (word == "cycle")
-    keyword = Keyword::Cycle;
-  else if (word == "ret")
-    keyword = Keyword::Ret;
-  else if (word == "and")
-    keyword = Keyword::And;
-  else if (word == "or")
-    keyword = Keyword::Or;
-  else if (word == "not")
-    keyword = Keyword::Not;
-  else if (word == "class")
-    keyword = Keyword::Class;
-  else if (word == "method")
-    keyword = Keyword::Method;
-  else if (word == "true") {
-    mCurrentToken = Token::booleanLiteral(begin, mSourceFile.position(), true);
-    return;
-  }
-  else if (word == "false") {
-    mCurrentToken = Token::booleanLiteral(begin, mSourceFile.position(), false);
-    return;
-  }
-  else {
-    mCurrentToken = Token::identifier(begin, mSourceFile.position(), move(word));
-    return;
-  }
-  mCurrentToken = Token::keyword(begin, mSourceFile.position(), keyword);
+    advanceCodePoint();
+    while ((mCursor = support::findEitherByte(mCursor, mEnd, '*', '/')) == mEnd) {
+      if (atEndOfFile())
+        throw std::runtime_error(support::concatenate("block comment starting on line ", positionAt(mCursor).line, ", column ", positionAt(mCursor).column, " not closed"));
+    }
+    if (*mCursor == '*') {
+      ++mCursor;
+      if (!atEndOfFile() && *mCursor == '/')
+        depth--;
+    }
+    else if (*mCursor == '/') {
+      ++mCursor;
+      if (!atEndOfFile() && *mCursor == '*')
+        depth++;
+    }
+  } while (depth > 0);
+  ++mCursor;
+}
+
+void Lexer::makeIdentifierOrKeyword(SourceLocation begin, std::string_view word)
+{
+  auto end = location(mCursor);
+  auto reserved_word = findReservedWord(word);
+  if (!reserved_word)
+    mCurrentToken = Token::identifier(begin, end, support::InternedString(word));
+  else if (reserved_word->isBooleanLiteral)
+    mCurrentToken = Token::booleanLiteral(begin, end, reserved_word->booleanLiteral);
+  else
+    mCurrentToken = Token::keyword(begin, end, reserved_word->keyword);
 }
 
 }
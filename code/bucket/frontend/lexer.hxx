@@ -2,38 +2,114 @@
 #define BUCKET_FRONTEND_LEXER_HXX
 
 #include "common.hxx"
+#include "frontend/literaltable.hxx"
 #include "frontend/sourcefile.hxx"
 #include "frontend/token.hxx"
+#include <string>
+#include <string_view>
 
 namespace frontend {
 
+// The lexer scans the raw bytes of the file rather than decoded characters.
+// A table maps each byte to a byte class, and a state transition table over
+// those classes recognizes symbols, numbers, and identifiers; string and
+// character literals, comments, runs of blanks, and non-ASCII identifiers
+// leave the tables for hand-written code.
 class Lexer {
 
 public:
 
-  explicit Lexer(const char* path);
+  Lexer(SourceManager& source_manager, SourceManager::FileId file);
+
+  // Lexes a file that is not streamed from 'start' on, as if the file began
+  // there, so 'start' must be a place where the lexer would be between two
+  // tokens. The file's reader is left alone, so several of these lexers can
+  // work on one file at the same time.
+  Lexer(SourceManager& source_manager, SourceManager::FileId file, SourceLocation start);
 
   Token& currentToken();
 
+  // the values of the literals of every token so far
+  const LiteralTable& literals() const noexcept;
+
+  // Moves the literal table out, once the lexer is no longer needed.
+  LiteralTable takeLiterals() noexcept;
+
   void next();
 
+  SourcePosition position(SourceLocation location) const noexcept;
+
 private:
 
   SourceFile mSourceFile;
 
   Token mCurrentToken;
 
-  void lexSymbol(Symbol symbol);
+  LiteralTable mLiterals;
+
+  // the bytes in memory that have not been scanned yet; mCursor only equals
+  // mEnd at end of file
+  const unsigned char* mCursor;
+
+  const unsigned char* mEnd;
+
+  // the first byte in memory and its location
+  const unsigned char* mChunkBegin;
+
+  SourceLocation mChunkLocation;
+
+  // the start and the text so far of a token that was split by the end of a
+  // chunk of streamed input; mCarriedBegin is invalid if there is none
+  SourceLocation mCarriedBegin;
+
+  std::string mCarriedText;
+
+  // true if the file's reader is shared with other lexers, in which case it
+  // is never moved past the bytes in memory
+  bool mSharesFile;
+
+  void refill();
+
+  void carry(const unsigned char* token_start, bool keep_text);
+
+  SourceLocation location(const unsigned char* position) const noexcept;
+
+  SourcePosition positionAt(const unsigned char* position) const noexcept;
+
+  // Returns where the token starting at 'token_start' begins, taking into
+  // account that it may have started in an earlier chunk.
+  SourceLocation tokenBegin(const unsigned char* token_start) noexcept;
+
+  std::string tokenText(const unsigned char* token_start, const unsigned char* token_end);
+
+  // Refills if the chunk has been used up.
+  bool atEndOfFile();
+
+  void advanceCodePoint();
+
+  support::UnicodeCharacter lexEscapedCharacter();
+
+  void lexStringLiteral(SourceLocation begin);
+
+  void lexCharacterLiteral(SourceLocation begin);
+
+  // Convert the number that starts at 'token_start' and ends at mCursor.
+  void lexIntegerLiteral(const unsigned char* token_start);
+
+  void lexRealLiteral(const unsigned char* token_start);
 
-  void lexStringLiteral();
+  // Returns false if the number is out of range.
+  template <typename Number>
+  bool convertNumber(const unsigned char* token_start, Number& value);
 
-  void lexCharacterLiteral();
+  void lexNonAsciiIdentifier(SourceLocation begin, const unsigned char* token_start);
 
-  void lexNumberOrPeriod();
+  void makeIdentifierOrKeyword(SourceLocation begin, std::string_view word);
 
-  void lexSlash();
+  // Skip to the newline or the end of the file, from the second '/'.
+  void skipLineComment();
 
-  void lexIdentifierOrKeyword();
+  void skipBlockComment();
 
 };
 
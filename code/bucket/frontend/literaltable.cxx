@@ -0,0 +1,19 @@
+#include "common.hxx"
+#include "frontend/literaltable.hxx"
+
+namespace frontend {
+
+LiteralTable::Indices LiteralTable::append(const LiteralTable& other)
+{
+  Indices indices{
+    static_cast<std::uint32_t>(mIntegers.size()),
+    static_cast<std::uint32_t>(mReals.size()),
+    static_cast<std::uint32_t>(mStrings.size())
+  };
+  mIntegers.insert(mIntegers.end(), other.mIntegers.begin(), other.mIntegers.end());
+  mReals.insert(mReals.end(), other.mReals.begin(), other.mReals.end());
+  mStrings.insert(mStrings.end(), other.mStrings.begin(), other.mStrings.end());
+  return indices;
+}
+
+}
@@ -0,0 +1,92 @@
+// literaltable.hxx
+// Defines the class LiteralTable, which holds the values of a file's literals
+// that do not fit in a token: integer and real literals, and the text of
+// string literals. Tokens refer to their values by index, which keeps every
+// token the same small size.
+
+#ifndef BUCKET_FRONTEND_LITERALTABLE_HXX
+#define BUCKET_FRONTEND_LITERALTABLE_HXX
+
+#include "common.hxx"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace frontend {
+
+class LiteralTable {
+
+public:
+
+  // the indices the first literals of another table get when it is appended
+  struct Indices {
+    std::uint32_t integers, reals, strings;
+  };
+
+  // These return the index of the value added. The text of a string literal
+  // is not copied, and must live as long as the table is used.
+
+  std::uint32_t addInteger(unsigned long value);
+
+  std::uint32_t addReal(double value);
+
+  std::uint32_t addString(std::string_view text);
+
+  unsigned long integer(std::uint32_t index) const noexcept;
+
+  double real(std::uint32_t index) const noexcept;
+
+  std::string_view string(std::uint32_t index) const noexcept;
+
+  // Adds the literals of 'other' after these ones.
+  Indices append(const LiteralTable& other);
+
+private:
+
+  std::vector<unsigned long> mIntegers;
+
+  std::vector<double> mReals;
+
+  std::vector<std::string_view> mStrings;
+
+};
+
+// every literal takes at least one byte of a file, and a file's locations fit
+// in 32 bits, so the indices do too
+
+inline std::uint32_t LiteralTable::addInteger(unsigned long value)
+{
+  mIntegers.push_back(value);
+  return static_cast<std::uint32_t>(mIntegers.size() - 1);
+}
+
+inline std::uint32_t LiteralTable::addReal(double value)
+{
+  mReals.push_back(value);
+  return static_cast<std::uint32_t>(mReals.size() - 1);
+}
+
+inline std::uint32_t LiteralTable::addString(std::string_view text)
+{
+  mStrings.push_back(text);
+  return static_cast<std::uint32_t>(mStrings.size() - 1);
+}
+
+inline unsigned long LiteralTable::integer(std::uint32_t index) const noexcept
+{
+  return mIntegers[index];
+}
+
+inline double LiteralTable::real(std::uint32_t index) const noexcept
+{
+  return mReals[index];
+}
+
+inline std::string_view LiteralTable::string(std::uint32_t index) const noexcept
+{
+  return mStrings[index];
+}
+
+}
+
+#endif
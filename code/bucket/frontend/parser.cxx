@@ -1,23 +1,186 @@
 #include "common.hxx"
 #include "frontend/parser.hxx"
 #include "support/concatenate.hxx"
+#include <array>
 #include <stdexcept>
 #include <iostream>
+#include <string_view>
+#include <vector>
 using namespace frontend;
 
 
-Parser::Parser(const char* path)
-: lexer(path)
+namespace {
+
+// the module, and the implicit receiver of bare calls
+const support::InternedString moduleName{"__module__"};
+const support::InternedString selfName{"__self__"};
+
+
+// How tightly a binary operator holds on to its operands. Of the two
+// operators around an operand, the one with the higher precedence takes it.
+// Unary operators come between multiplication and exponentiation.
+enum Precedence : unsigned char {
+  NotAnOperator, Disjunction, Conjunction, Equality, Comparison, Additive,
+  Multiplicative, Unary, Exponent
+};
+
+
+// Which of two operators of the same precedence takes the operand between
+// them. None means that they may not be written next to each other.
+enum class Associativity : unsigned char {
+  Left, Right, None
+};
+
+
+// An operator and the method it is turned into a call of. The name is
+// looked up once here rather than for every call.
+struct Operator {
+  ast::OperatorKind kind = ast::OperatorKind::None;
+  support::InternedString name;
+  Operator() = default;
+  Operator(ast::OperatorKind kind) : kind(kind), name(ast::operatorName(kind)) {}
+};
+
+
+struct BinaryOperator {
+  Precedence precedence = NotAnOperator;
+  Associativity associativity = Associativity::Left;
+  Operator op;
+};
+
+
+constexpr std::size_t SYMBOL_COUNT = static_cast<std::size_t>(Symbol::EndOfFile) + 1;
+
+constexpr std::size_t KEYWORD_COUNT = static_cast<std::size_t>(Keyword::Method) + 1;
+
+
+// The binary and unary operators, by the symbol or keyword they are written
+// with.
+struct OperatorTable {
+  std::array<BinaryOperator, SYMBOL_COUNT> binary_symbols;
+  std::array<BinaryOperator, KEYWORD_COUNT> binary_keywords;
+  std::array<Operator, SYMBOL_COUNT> unary_symbols;
+  std::array<Operator, KEYWORD_COUNT> unary_keywords;
+  Operator call{ast::OperatorKind::Call};
+  Operator index{ast::OperatorKind::Index};
+  OperatorTable();
+};
+
+
+OperatorTable::OperatorTable()
+{
+  using ast::OperatorKind;
+  auto binary = [&](Symbol symbol, Precedence precedence, Associativity associativity, OperatorKind kind) {
+    binary_symbols[static_cast<std::size_t>(symbol)] = BinaryOperator{precedence, associativity, kind};
+  };
+  binary_keywords[static_cast<std::size_t>(Keyword::Or)] = BinaryOperator{Disjunction, Associativity::Right, OperatorKind::Or};
+  binary_keywords[static_cast<std::size_t>(Keyword::And)] = BinaryOperator{Conjunction, Associativity::Right, OperatorKind::And};
+  binary(Symbol::DoubleEquals, Equality, Associativity::None, OperatorKind::Equal);
+  binary(Symbol::BangEquals, Equality, Associativity::None, OperatorKind::NotEqual);
+  binary(Symbol::Greater, Comparison, Associativity::None, OperatorKind::Greater);
+  binary(Symbol::GreaterOrEqual, Comparison, Associativity::None, OperatorKind::GreaterOrEqual);
+  binary(Symbol::Lesser, Comparison, Associativity::None, OperatorKind::Lesser);
+  binary(Symbol::LesserOrEqual, Comparison, Associativity::None, OperatorKind::LesserOrEqual);
+  binary(Symbol::Plus, Additive, Associativity::Left, OperatorKind::Add);
+  binary(Symbol::Minus, Additive, Associativity::Left, OperatorKind::Subtract);
+  binary(Symbol::Asterisk, Multiplicative, Associativity::Left, OperatorKind::Multiply);
+  binary(Symbol::Slash, Multiplicative, Associativity::Left, OperatorKind::Divide);
+  binary(Symbol::PercentSign, Multiplicative, Associativity::Left, OperatorKind::Modulo);
+  binary(Symbol::Caret, Exponent, Associativity::Right, OperatorKind::Power);
+
+  unary_symbols[static_cast<std::size_t>(Symbol::Plus)] = OperatorKind::Positive;
+  unary_symbols[static_cast<std::size_t>(Symbol::Minus)] = OperatorKind::Negative;
+  unary_symbols[static_cast<std::size_t>(Symbol::Asterisk)] = OperatorKind::Dereference;
+  unary_symbols[static_cast<std::size_t>(Symbol::Ampersand)] = OperatorKind::AddressOf;
+  unary_keywords[static_cast<std::size_t>(Keyword::Not)] = OperatorKind::Not;
+}
+
+
+const OperatorTable operators;
+
+const BinaryOperator notAnOperator;
+
+const Operator notAPrefixOperator;
+
+
+// Returns the binary operator that the current token is, which has no
+// precedence if the token is not one.
+const BinaryOperator& currentBinaryOperator(const TokenCursor& tokens) noexcept
+{
+  switch (tokens.kind()) {
+    case TokenKind::Symbol:
+      return operators.binary_symbols[static_cast<std::size_t>(tokens.symbol())];
+    case TokenKind::Keyword:
+      return operators.binary_keywords[static_cast<std::size_t>(tokens.keyword())];
+    default:
+      return notAnOperator;
+  }
+}
+
+
+// Returns the unary operator that the current token is, which is of kind
+// None if the token is not one.
+const Operator& currentPrefixOperator(const TokenCursor& tokens) noexcept
+{
+  switch (tokens.kind()) {
+    case TokenKind::Symbol:
+      return operators.unary_symbols[static_cast<std::size_t>(tokens.symbol())];
+    case TokenKind::Keyword:
+      return operators.unary_keywords[static_cast<std::size_t>(tokens.keyword())];
+    default:
+      return notAPrefixOperator;
+  }
+}
+
+
+// Makes the call that an operator is turned into.
+ast::Call* createOperatorCall(ast::Context& context, const Operator& op, ast::Expression* object)
+{
+  auto call = context.create<ast::Call>();
+  call->object = object;
+  call->name = op.name;
+  call->op = op.kind;
+  return call;
+}
+
+
+// The current operator as it is written, for error messages.
+std::string_view currentSpelling(const TokenCursor& tokens) noexcept
+{
+  if (tokens.kind() == TokenKind::Keyword)
+    return keywordToString(tokens.keyword());
+  return symbolToString(tokens.symbol());
+}
+
+
+// Moves the entries of 'stack' past 'mark' into a list in 'context'.
+template <typename T>
+ast::List<T> popList(ast::Context& context, std::vector<T>& stack, std::size_t mark)
+{
+  auto list = context.list(stack.data() + mark, stack.size() - mark);
+  stack.resize(mark);
+  return list;
+}
+
+}
+
+
+Parser::Parser(ast::Context& context, SourceManager& source_manager, SourceManager::FileId file, unsigned lexer_threads)
+: context(context),
+  source_manager(source_manager),
+  tokens(source_manager, file, lexer_threads),
+  self(nullptr)
 {}
 
 
-std::unique_ptr<ast::Class> Parser::parse()
+ast::Class* Parser::parse()
 {
-  auto program = std::make_unique<ast::Class>();
-  program->name = "__module__";
+  auto program = context.create<ast::Class>();
+  program->name = moduleName;
+  auto mark = global_statements.size();
   while (true) {
     if (auto ptr = parseGlobalStatement()) {
-      program->body.push_back(std::move(ptr));
+      global_statements.push_back(ptr);
       continue;
     }
     if (accept(Symbol::Newline))
@@ -26,13 +189,14 @@ std::unique_ptr<ast::Class> Parser::parse()
       break;
     throw std::runtime_error("expected global statement, newline, or end of file");
   }
+  program->body = popList(context, global_statements, mark);
   return program;
 }
 
 
-std::unique_ptr<ast::GlobalStatement> Parser::parseGlobalStatement()
+ast::GlobalStatement* Parser::parseGlobalStatement()
 {
-  if (std::unique_ptr<ast::GlobalStatement> ptr;
+  if (ast::GlobalStatement* ptr;
     (ptr = parseClassDefinition()) ||
     (ptr = parseMethodDefinition()) ||
     (ptr = parseMemberVariable())
@@ -41,11 +205,11 @@ std::unique_ptr<ast::GlobalStatement> Parser::parseGlobalStatement()
 }
 
 
-std::unique_ptr<ast::Class> Parser::parseClassDefinition()
+ast::Class* Parser::parseClassDefinition()
 {
   if (!accept(Keyword::Class))
     return nullptr;
-  auto class_definition = std::make_unique<ast::Class>();
+  auto class_definition = context.create<ast::Class>();
   if ((class_definition->name = getIdentifierString()).empty())
     throw std::runtime_error("expected identifier after \'class\'");
   //if (accept(Symbol::Lesser)) {
@@ -53,23 +217,26 @@ std::unique_ptr<ast::Class> Parser::parseClassDefinition()
   //    throw std::runtime_error("expected postfix expression after \'is\'");
   //}
   expect(Symbol::Newline);
+  auto mark = global_statements.size();
   while (auto ptr = parseGlobalStatement())
-    class_definition->body.push_back(std::move(ptr));
+    global_statements.push_back(ptr);
+  class_definition->body = popList(context, global_statements, mark);
   expect(Keyword::End);
   expect(Symbol::Newline);
   return class_definition;
 }
 
 
-std::unique_ptr<ast::Method> Parser::parseMethodDefinition()
+ast::Method* Parser::parseMethodDefinition()
 {
   if (!accept(Keyword::Method))
     return nullptr;
-  auto method_definition = std::make_unique<ast::Method>();
+  auto method_definition = context.create<ast::Method>();
   if ((method_definition->name = getIdentifierString()).empty())
     throw std::runtime_error("expected identifier after \'method\'");
   if (accept(Symbol::OpenParenthesis)) {
     if (!accept(Symbol::CloseParenthesis)) {
+      auto mark = parameters.size();
       do {
         auto arg_name = getIdentifierString();
         if (arg_name.empty())
@@ -78,9 +245,10 @@ std::unique_ptr<ast::Method> Parser::parseMethodDefinition()
         auto arg_class = parsePostfixExpression();
         if (!arg_class)
           throw std::runtime_error("expected class");
-        method_definition->args.emplace_back(std::move(arg_name), std::move(arg_class));
+        parameters.emplace_back(std::move(arg_name), arg_class);
       } while (accept(Symbol::Comma));
       expect(Symbol::CloseParenthesis);
+      method_definition->args = popList(context, parameters, mark);
     }
   }
   if (accept(Symbol::Colon)) {
@@ -88,8 +256,7 @@ std::unique_ptr<ast::Method> Parser::parseMethodDefinition()
       throw std::runtime_error("expected return type after arrow");
   }
   expect(Symbol::Newline);
-  while (auto ptr = parseStatement())
-    method_definition->body.push_back(std::move(ptr));
+  method_definition->body = parseStatements();
   expect(Keyword::End);
   if (!accept(Symbol::Newline) && !accept(Symbol::EndOfFile))
     throw std::runtime_error("expected newline or eof");
@@ -97,11 +264,13 @@ std::unique_ptr<ast::Method> Parser::parseMethodDefinition()
 }
 
 
-std::unique_ptr<ast::Field> Parser::parseMemberVariable()
+ast::Field* Parser::parseMemberVariable()
 {
-  auto member_variable = std::make_unique<ast::Field>();
-  if ((member_variable->name = getIdentifierString()).empty())
+  auto name = getIdentifierString();
+  if (name.empty())
     return nullptr;
+  auto member_variable = context.create<ast::Field>();
+  member_variable->name = name;
   expect(Symbol::Colon);
   if (!(member_variable->cls = parseExpression()))
     throw std::runtime_error("expected expression in member variable");
@@ -110,7 +279,7 @@ std::unique_ptr<ast::Field> Parser::parseMemberVariable()
 }
 
 
-std::unique_ptr<ast::Statement> Parser::parseStatement()
+ast::Statement* Parser::parseStatement()
 {
   if (auto ptr = parseIf())
     return ptr;
@@ -120,16 +289,16 @@ std::unique_ptr<ast::Statement> Parser::parseStatement()
 
   if (accept(Keyword::Break)) {
     expect(Symbol::Newline);
-    return std::make_unique<ast::Break>();
+    return context.create<ast::Break>();
   }
 
   if (accept(Keyword::Cycle)) {
     expect(Symbol::Newline);
-    return std::make_unique<ast::Cycle>();
+    return context.create<ast::Cycle>();
   }
 
   if (accept(Keyword::Ret)) {
-    auto ret = std::make_unique<ast::Ret>();
+    auto ret = context.create<ast::Ret>();
     ret->value = parseExpression();
     expect(Symbol::Newline);
     return ret;
@@ -137,8 +306,8 @@ std::unique_ptr<ast::Statement> Parser::parseStatement()
 
   if (auto ptr = parseExpression()) {
     expect(Symbol::Newline);
-    auto expression_statement = std::make_unique<ast::ExpressionStatement>();
-    expression_statement->value = std::move(ptr);
+    auto expression_statement = context.create<ast::ExpressionStatement>();
+    expression_statement->value = ptr;
     return expression_statement;
   }
 
@@ -147,58 +316,64 @@ std::unique_ptr<ast::Statement> Parser::parseStatement()
 }
 
 
-std::unique_ptr<ast::If> Parser::parseIf()
+ast::If* Parser::parseIf()
 {
   if (!accept(Keyword::If))
     return nullptr;
-  auto if_ = std::make_unique<ast::If>();
+  auto if_ = context.create<ast::If>();
   if (!(if_->condition = parseExpression()))
     throw std::runtime_error("expected expression after \'if\'");
   expect(Symbol::Newline);
-  while (auto statement = parseStatement())
-    if_->if_body.push_back(std::move(statement));
+  if_->if_body = parseStatements();
+  auto mark = elifs.size();
   while (accept(Keyword::Elif)) {
     auto expression = parseExpression();
     if (!expression)
       throw std::runtime_error("expected expression after \'elif\'");
     expect(Symbol::Newline);
-    std::vector<std::unique_ptr<ast::Statement>> statements;
-    while (auto statement = parseStatement())
-      statements.push_back(std::move(statement));
-    if_->elif_bodies.emplace_back(std::move(expression), std::move(statements));
+    auto statements = parseStatements();
+    elifs.emplace_back(expression, statements);
   }
+  if_->elif_bodies = popList(context, elifs, mark);
   if (accept(Keyword::Else)) {
     expect(Symbol::Newline);
-    while (auto statement = parseStatement())
-      if_->else_body.push_back(std::move(statement));
+    if_->else_body = parseStatements();
   }
   expect(Keyword::End);
   return if_;
 }
 
 
-std::unique_ptr<ast::Loop> Parser::parseLoop()
+ast::Loop* Parser::parseLoop()
 {
   if (!accept(Keyword::Do))
     return nullptr;
   expect(Symbol::Newline);
-  auto loop = std::make_unique<ast::Loop>();
-  while (auto statement = parseStatement())
-    loop->body.push_back(std::move(statement));
+  auto loop = context.create<ast::Loop>();
+  loop->body = parseStatements();
   expect(Keyword::End);
   expect(Symbol::Newline);
   return loop;
 }
 
 
-std::unique_ptr<ast::Expression> Parser::parseExpression()
+ast::List<ast::Statement*> Parser::parseStatements()
 {
-  auto ptr = parseOrExpression();
+  auto mark = statements.size();
+  while (auto statement = parseStatement())
+    statements.push_back(statement);
+  return popList(context, statements, mark);
+}
+
+
+ast::Expression* Parser::parseExpression()
+{
+  auto ptr = parseBinaryExpression(Disjunction);
   if (!ptr)
     return nullptr;
   if (accept(Symbol::SingleEquals)) {
-    auto assignment = std::make_unique<ast::Assignment>();
-    assignment->left = std::move(ptr);
+    auto assignment = context.create<ast::Assignment>();
+    assignment->left = ptr;
     if (!(assignment->right = parseExpression()))
       throw std::runtime_error("expected expression on rhs");
     return assignment;
@@ -207,214 +382,47 @@ std::unique_ptr<ast::Expression> Parser::parseExpression()
 }
 
 
-std::unique_ptr<ast::Expression> Parser::parseOrExpression()
-{
-  auto expression = parseAndExpression();
-  if (!expression)
-    return nullptr;
-  if (!accept(Keyword::Or))
-    return expression;
-  auto call = std::make_unique<ast::Call>();
-  call->object = std::move(expression);
-  call->name = "__or__";
-  expression = parseOrExpression();
-  if (!expression)
-    throw std::runtime_error("expected expression after 'or'");
-  call->args.push_back(std::move(expression));
-  return call;
-}
-
-
-std::unique_ptr<ast::Expression> Parser::parseAndExpression()
-{
-  auto expression = parseEqualityExpression();
-  if (!expression)
-    return nullptr;
-  if (!accept(Keyword::Or))
-    return expression;
-  auto call = std::make_unique<ast::Call>();
-  call->object = std::move(expression);
-  call->name = "__and__";
-  expression = parseAndExpression();
-  if (!expression)
-    throw std::runtime_error("expected expression after 'and'");
-  call->args.push_back(std::move(expression));
-  return call;
-}
-
-
-std::unique_ptr<ast::Expression> Parser::parseEqualityExpression()
-{
-  auto expression = parseComparisonExpression();
-  if (!expression)
-    return nullptr;
-  std::string name;
-  if (accept(Symbol::DoubleEquals))
-    name = "__eq__";
-  else if (accept(Symbol::BangEquals))
-    name = "__ne__";
-  else
-    return expression;
-  auto call = std::make_unique<ast::Call>();
-  call->object = std::move(expression);
-  call->name = std::move(name);
-  expression = parseComparisonExpression();
-  if (!expression)
-    throw std::runtime_error("expected expression after equality");
-  call->args.push_back(std::move(expression));
-  return call;
-}
-
-
-std::unique_ptr<ast::Expression> Parser::parseComparisonExpression()
-{
-  auto expression = parseArithmeticExpression();
-  if (!expression)
-    return nullptr;
-  std::string name;
-  if (accept(Symbol::Greater))
-    name = "__gt__";
-  else if (accept(Symbol::GreaterOrEqual))
-    name = "__ge__";
-  else if (accept(Symbol::Lesser))
-    name = "__lt__";
-  else if (accept(Symbol::LesserOrEqual))
-    name = "__le__";
-  else
-    return expression;
-  auto call = std::make_unique<ast::Call>();
-  call->object = std::move(expression);
-  call->name = std::move(name);
-  expression = parseArithmeticExpression();
-  if (!expression)
-    throw std::runtime_error("expected expression after equality");
-  call->args.push_back(std::move(expression));
-  return call;
-}
-
-
-std::unique_ptr<ast::Expression> Parser::parseArithmeticExpression()
+ast::Expression* Parser::parseBinaryExpression(unsigned min_precedence)
 {
-  auto expression = parseTerm();
-  if (!expression)
+  auto left = parseUnaryExpression();
+  if (!left)
     return nullptr;
-  std::string name;
-  if (accept(Symbol::Plus))
-    name = "__add__";
-  else if (accept(Symbol::Minus))
-    name = "__sub__";
-  else
-    return expression;
-  auto call = std::make_unique<ast::Call>();
-  call->object = std::move(expression);
-  call->name = std::move(name);
-  expression = parseTerm();
-  if (!expression)
-    throw std::runtime_error("expected expression after plus/minus");
-  call->args.push_back(std::move(expression));
   while (true) {
-    if (accept(Symbol::Plus))
-      name = "__add__";
-    else if (accept(Symbol::Minus))
-      name = "__sub__";
-    else
-      return std::move(call);
-    auto new_call = std::make_unique<ast::Call>();
-    new_call->object = std::move(call);
-    new_call->name = std::move(name);
-    expression = parseTerm();
-    if (!expression)
-      throw std::runtime_error("expected expression after plus/minus");
-    new_call->args.push_back(std::move(expression));
-    call = std::move(new_call);
+    auto& op = currentBinaryOperator(tokens);
+    if (op.precedence < min_precedence)
+      return left;
+    auto spelling = currentSpelling(tokens);
+    tokens.advance();
+    // the right operand is made of the operators that bind tighter, and of
+    // the same operator too if it is right associative
+    auto right = parseBinaryExpression(op.associativity == Associativity::Right ? op.precedence : op.precedence + 1);
+    if (!right)
+      throw std::runtime_error(support::concatenate("expected expression after '", spelling, '\''));
+    auto call = createOperatorCall(context, op.op, left);
+    call->args = context.list(&right, 1);
+    left = call;
+    if (op.associativity == Associativity::None && currentBinaryOperator(tokens).precedence == op.precedence)
+      throw std::runtime_error(support::concatenate("'", currentSpelling(tokens), "' cannot follow '", spelling, "' without parentheses"));
   }
 }
 
 
-std::unique_ptr<ast::Expression> Parser::parseTerm()
+ast::Expression* Parser::parseUnaryExpression()
 {
-  auto expression = parseFactor();
-  if (!expression)
-    return nullptr;
-  std::string name;
-  if (accept(Symbol::Asterisk))
-    name = "__mul__";
-  else if (accept(Symbol::Slash))
-    name = "__div__";
-  else if (accept(Symbol::PercentSign))
-    name = "__mod__";
-  else
-    return expression;
-  auto call = std::make_unique<ast::Call>();
-  call->object = std::move(expression);
-  call->name = std::move(name);
-  expression = parseFactor();
-  if (!expression)
-    throw std::runtime_error("expected expression after times/divide/modulo");
-  call->args.push_back(std::move(expression));
-  while (true) {
-    if (accept(Symbol::Asterisk))
-      name = "__mul__";
-    else if (accept(Symbol::Slash))
-      name = "__div__";
-    else if (accept(Symbol::PercentSign))
-      name = "__mod__";
-    else
-      return call;
-    auto new_call = std::make_unique<ast::Call>();
-    new_call->object = std::move(call);
-    new_call->name = std::move(name);
-    expression = parseTerm();
-    if (!expression)
-      throw std::runtime_error("expected expression after plus/minus");
-    new_call->args.push_back(std::move(expression));
-    call = std::move(new_call);
-  }
+  auto& op = currentPrefixOperator(tokens);
+  if (op.kind == ast::OperatorKind::None)
+    return parsePostfixExpression();
+  auto spelling = currentSpelling(tokens);
+  tokens.advance();
+  // an exponent binds tighter, so '-a ^ b' is '-(a ^ b)'
+  auto operand = parseBinaryExpression(Exponent);
+  if (!operand)
+    throw std::runtime_error(support::concatenate("expected expression after '", spelling, '\''));
+  return createOperatorCall(context, op, operand);
 }
 
 
-std::unique_ptr<ast::Expression> Parser::parseFactor()
-{
-  std::string name;
-  if (accept(Symbol::Plus))
-    name = "__pos__";
-  else if (accept(Symbol::Minus))
-    name = "__neg__";
-  else if (accept(Keyword::Not))
-    name = "__not__";
-  else if (accept(Symbol::Asterisk))
-    name = "__dereference__";
-  else if (accept(Symbol::Ampersand))
-    name = "__addressof__";
-  else
-    return parseExponent();
-  auto call = std::make_unique<ast::Call>();
-  if (!(call->object = parseFactor()))
-    throw std::runtime_error("I'm too lazy to keep writing error messages");
-  call->name = std::move(name);
-  return call;
-}
-
-
-std::unique_ptr<ast::Expression> Parser::parseExponent()
-{
-  auto expression = parsePostfixExpression();
-  if (!expression)
-    return nullptr;
-  if (accept(Symbol::Caret)) {
-    auto call = std::make_unique<ast::Call>();
-    call->object = std::move(expression);
-    call->name = "__pow__";
-    if (!(expression = parseFactor()))
-      throw std::runtime_error("foo");
-    call->args.push_back(std::move(expression));
-    return call;
-  }
-  return expression;
-}
-
-
-std::unique_ptr<ast::Expression> Parser::parsePostfixExpression()
+ast::Expression* Parser::parsePostfixExpression()
 {
   auto expression = parseSimpleExpression();
   while (true) {
@@ -428,71 +436,62 @@ std::unique_ptr<ast::Expression> Parser::parsePostfixExpression()
 }
 
 
-bool Parser::parseMethodOrAccess(std::unique_ptr<ast::Expression>& expression)
+bool Parser::parseMethodOrAccess(ast::Expression*& expression)
 {
   if (!accept(Symbol::Period))
     return false;
   auto name = expectIdentifier();
   if (name.empty())
     throw std::runtime_error("expected identifier after '.'");
-  auto call = std::make_unique<ast::Call>();
+  auto call = context.create<ast::Call>();
   call->name = std::move(name);
   if (accept(Symbol::OpenParenthesis)) {
-    if (!accept(Symbol::CloseParenthesis)) {
-      do {
-        auto arg = parseExpression();
-        if (!arg)
-          throw std::runtime_error("expected argument");
-        call->args.push_back(std::move(arg));
-      } while (accept(Symbol::Comma));
-      expect(Symbol::CloseParenthesis);
-    }
+    if (!accept(Symbol::CloseParenthesis))
+      call->args = parseArguments(Symbol::CloseParenthesis);
   }
-  call->object = std::move(expression);
-  expression = std::move(call);
+  call->object = expression;
+  expression = call;
   return true;
 }
 
 
-bool Parser::parseCall(std::unique_ptr<ast::Expression>& expression)
+bool Parser::parseCall(ast::Expression*& expression)
 {
   if (!accept(Symbol::OpenParenthesis))
     return false;
-  auto call = std::make_unique<ast::Call>();
-  call->name = "__call__";
-  do {
-    auto arg = parseExpression();
-    if (!arg)
-      throw std::runtime_error("expected argument");
-    call->args.push_back(std::move(arg));
-  } while (accept(Symbol::Comma));
-  expect(Symbol::CloseParenthesis);
-  call->object = std::move(expression);
-  expression = std::move(call);
+  auto call = createOperatorCall(context, operators.call, expression);
+  call->args = parseArguments(Symbol::CloseParenthesis);
+  expression = call;
   return true;
 }
 
 
-bool Parser::parseIndex(std::unique_ptr<ast::Expression>& expression)
+bool Parser::parseIndex(ast::Expression*& expression)
 {
   if (!accept(Symbol::OpenSquareBracket))
     return false;
-  auto call = std::make_unique<ast::Call>();
-  call->name = "__index__";
+  auto call = createOperatorCall(context, operators.index, expression);
+  call->args = parseArguments(Symbol::CloseSquareBracket);
+  expression = call;
+  return true;
+}
+
+
+ast::List<ast::Expression*> Parser::parseArguments(Symbol close)
+{
+  auto mark = arguments.size();
   do {
     auto arg = parseExpression();
     if (!arg)
       throw std::runtime_error("expected argument");
-    call->args.push_back(std::move(arg));
+    arguments.push_back(arg);
   } while (accept(Symbol::Comma));
-  expect(Symbol::CloseSquareBracket);
-  call->object = std::move(expression);
-  expression = std::move(call);
-  return true;
+  expect(close);
+  return popList(context, arguments, mark);
 }
 
 
-std::unique_ptr<ast::Expression> Parser::parseSimpleExpression()
+ast::Expression* Parser::parseSimpleExpression()
 {
   if (auto expression = parseIdentifier())
     return expression;
@@ -509,88 +508,92 @@ std::unique_ptr<ast::Expression> Parser::parseSimpleExpression()
 }
 
 
-std::unique_ptr<ast::Expression> Parser::parseIdentifier()
+ast::Expression* Parser::parseIdentifier()
 {
   auto identifier_string = getIdentifierString();
   if (identifier_string.empty())
     return nullptr;
   if (accept(Symbol::OpenParenthesis)) {
-    auto call = std::make_unique<ast::Call>();
-    auto obj = std::make_unique<ast::Identifier>();
-    obj->value = "__self__";
-    call->object = std::move(obj);
-    call->name = std::move(identifier_string);
-    if (!accept(Symbol::CloseParenthesis)) {
-      do {
-        auto arg = parseExpression();
-        if (!arg)
-          throw std::runtime_error("expected argument");
-        call->args.push_back(std::move(arg));
-      } while (accept(Symbol::Comma));
-      expect(Symbol::CloseParenthesis);
+    if (!self) {
+      self = context.create<ast::Identifier>();
+      self->value = selfName;
     }
+    auto call = context.create<ast::Call>();
+    call->object = self;
+    call->name = std::move(identifier_string);
+    if (!accept(Symbol::CloseParenthesis))
+      call->args = parseArguments(Symbol::CloseParenthesis);
     return call;
   }
-  auto identifier = std::make_unique<ast::Identifier>();
+  auto identifier = context.create<ast::Identifier>();
   identifier->value = std::move(identifier_string);
   return identifier;
 }
 
 
-std::unique_ptr<ast::Expression> Parser::parseLiteral()
+ast::Expression* Parser::parseLiteral()
 {
-  if (auto ptr = lexer.currentToken().getIntegerLiteral()) {
-    auto integer = std::make_unique<ast::Integer>();
-    integer->value = *ptr;
-    lexer.next();
-    return integer;
+  ast::Expression* literal;
+  switch (tokens.kind()) {
+    case TokenKind::IntegerLiteral:
+      {
+        auto integer = context.create<ast::Integer>();
+        integer->value = tokens.integerLiteral();
+        literal = integer;
+        break;
+      }
+    case TokenKind::RealLiteral:
+      {
+        auto real = context.create<ast::Real>();
+        real->value = tokens.realLiteral();
+        literal = real;
+        break;
+      }
+    case TokenKind::StringLiteral:
+      {
+        auto str = context.create<ast::String>();
+        str->value = tokens.stringLiteral();
+        literal = str;
+        break;
+      }
+    case TokenKind::CharacterLiteral:
+      {
+        auto character = context.create<ast::Character>();
+        character->value = tokens.characterLiteral();
+        literal = character;
+        break;
+      }
+    case TokenKind::BooleanLiteral:
+      {
+        auto boolean = context.create<ast::Bool>();
+        boolean->value = tokens.booleanLiteral();
+        literal = boolean;
+        break;
+      }
+    default:
+      return nullptr;
   }
-  if (auto ptr = lexer.currentToken().getRealLiteral()) {
-    auto real = std::make_unique<ast::Real>();
-    real->value = *ptr;
-    lexer.next();
-    return real;
-  }
-  if (auto ptr = lexer.currentToken().getStringLiteral()) {
-    auto str = std::make_unique<ast::String>();
-    str->value = std::move(*ptr);
-    lexer.next();
-    return str;
-  }
-  if (auto ptr = lexer.currentToken().getCharacterLiteral()) {
-    auto character = std::make_unique<ast::Character>();
-    character->value = *ptr;
-    lexer.next();
-    return character;
-  }
-  if (auto ptr = lexer.currentToken().getBooleanLiteral()) {
-    auto boolean = std::make_unique<ast::Bool>();
-    boolean->value = *ptr;
-    lexer.next();
-    return boolean;
-  }
-  return nullptr;
+  tokens.advance();
+  return literal;
 }
 
 
-std::string Parser::getIdentifierString()
+support::InternedString Parser::getIdentifierString()
 {
-  if (auto ptr = lexer.currentToken().getIdentifier()) {
-    auto str = std::move(*ptr);
-    lexer.next();
-    return str;
-  }
-  return "";
+  if (tokens.kind() != TokenKind::Identifier)
+    return support::InternedString();
+  auto str = tokens.identifier();
+  tokens.advance();
+  return str;
 }
 
 
-std::string Parser::expectIdentifier()
+support::InternedString Parser::expectIdentifier()
 {
-  auto ptr = lexer.currentToken().getIdentifier();
-  if (!ptr)
+  if (tokens.kind() != TokenKind::Identifier)
     throw std::runtime_error("expected identifier");
-  auto result = std::move(*ptr);
-  lexer.next();
+  auto result = tokens.identifier();
+  tokens.advance();
   return result;
 }
 
@@ -605,16 +608,16 @@ void Parser::expect(Keyword keyword)
 void Parser::expect(Symbol symbol)
 {
   if (!accept(symbol)) {
-    std::cerr << lexer.currentToken();
-    throw std::runtime_error(support::concatenate("expected symbol '", symbolToString(symbol), "' (~line ", lexer.currentToken().begin.line, ")"));
+    print(std::cerr, tokens.token(), tokens.literals());
+    throw std::runtime_error(support::concatenate("expected symbol '", symbolToString(symbol), "' (~line ", source_manager.position(tokens.begin()).line, ")"));
   }
 }
 
 
 bool Parser::accept(Keyword keyword)
 {
-  if (auto ptr = lexer.currentToken().getKeyword(); ptr && *ptr == keyword) {
-    lexer.next();
+  if (tokens.kind() == TokenKind::Keyword && tokens.keyword() == keyword) {
+    tokens.advance();
     return true;
   }
   return false;
@@ -623,9 +626,10 @@ bool Parser::accept(Keyword keyword)
 
 bool Parser::accept(Symbol symbol)
 {
-  if (auto ptr = lexer.currentToken().getSymbol(); ptr && *ptr == symbol) {
-    lexer.next();
+  if (tokens.kind() == TokenKind::Symbol && tokens.symbol() == symbol) {
+    tokens.advance();
     return true;
   }
   return false;
 }
+
@@ -1,10 +1,14 @@
 #pragma once
 #include "common.hxx"
 #include "abstract_syntax_tree/abstract_syntax_tree.hxx"
-#include "frontend/lexer.hxx"
+#include "abstract_syntax_tree/context.hxx"
+#include "frontend/sourcemanager.hxx"
 #include "frontend/token.hxx"
-#include <memory>
-#include <string>
+#include "frontend/tokencursor.hxx"
+#include "support/stringinterner.hxx"
+#include <cstddef>
+#include <utility>
+#include <vector>
 
 
 namespace frontend {
@@ -14,63 +18,80 @@ class Parser {
 
 public:
 
-  explicit Parser(const char* path);
+  // The tree is built in 'context', and lives as long as the context does.
+  // 'lexer_threads' is passed on to the TokenCursor.
+  Parser(ast::Context& context, SourceManager& source_manager, SourceManager::FileId file, unsigned lexer_threads = 1);
 
-  std::unique_ptr<ast::Class> parse();
+  ast::Class* parse();
 
 private:
 
-  Lexer lexer;
+  ast::Context& context;
 
-  std::unique_ptr<ast::GlobalStatement> parseGlobalStatement();
+  SourceManager& source_manager;
 
-  std::unique_ptr<ast::Class> parseClassDefinition();
+  // a whole file is lexed before parsing starts, a streamed one as it goes
+  TokenCursor tokens;
 
-  std::unique_ptr<ast::Method> parseMethodDefinition();
+  // the receiver of calls that name no object, one node shared by all of
+  // them
+  ast::Identifier* self;
 
-  std::unique_ptr<ast::Field> parseMemberVariable();
+  // Children are gathered on these stacks while their parent is parsed, and
+  // then copied into the context in one piece. Nested lists are gathered on
+  // top of the ones that contain them.
+  std::vector<ast::GlobalStatement*> global_statements;
+  std::vector<ast::Statement*> statements;
+  std::vector<ast::Expression*> arguments;
+  std::vector<std::pair<support::InternedString, ast::Expression*>> parameters;
+  std::vector<std::pair<ast::Expression*, ast::List<ast::Statement*>>> elifs;
 
-  std::unique_ptr<ast::Statement> parseStatement();
+  ast::GlobalStatement* parseGlobalStatement();
 
-  std::unique_ptr<ast::If> parseIf();
+  ast::Class* parseClassDefinition();
 
-  std::unique_ptr<ast::Loop> parseLoop();
+  ast::Method* parseMethodDefinition();
 
-  std::unique_ptr<ast::Expression> parseExpression();
+  ast::Field* parseMemberVariable();
 
-  std::unique_ptr<ast::Expression> parseOrExpression();
+  ast::Statement* parseStatement();
 
-  std::unique_ptr<ast::Expression> parseAndExpression();
+  ast::If* parseIf();
 
-  std::unique_ptr<ast::Expression> parseEqualityExpression();
+  ast::Loop* parseLoop();
 
-  std::unique_ptr<ast::Expression> parseComparisonExpression();
+  // Parses statements up to the first line that is not one.
+  ast::List<ast::Statement*> parseStatements();
 
-  std::unique_ptr<ast::Expression> parseArithmeticExpression();
+  ast::Expression* parseExpression();
 
-  std::unique_ptr<ast::Expression> parseTerm();
+  // Parses operands joined by binary operators that bind at least as
+  // tightly as 'min_precedence' (see the table in parser.cxx), and turns
+  // each operator into a call.
+  ast::Expression* parseBinaryExpression(unsigned min_precedence);
 
-  std::unique_ptr<ast::Expression> parseFactor();
+  ast::Expression* parseUnaryExpression();
 
-  std::unique_ptr<ast::Expression> parseExponent();
+  ast::Expression* parsePostfixExpression();
 
-  std::unique_ptr<ast::Expression> parsePostfixExpression();
+  bool parseMethodOrAccess(ast::Expression*& expression);
 
-  bool parseMethodOrAccess(std::unique_ptr<ast::Expression>& expression);
+  bool parseCall(ast::Expression*& expression);
 
-  bool parseCall(std::unique_ptr<ast::Expression>& expression);
+  bool parseIndex(ast::Expression*& expression);
 
-  bool parseIndex(std::unique_ptr<ast::Expression>& expression);
+  // Parses one or more comma-separated expressions and then 'close'.
+  ast::List<ast::Expression*> parseArguments(Symbol close);
 
-  std::unique_ptr<ast::Expression> parseSimpleExpression();
+  ast::Expression* parseSimpleExpression();
 
-  std::unique_ptr<ast::Expression> parseIdentifier();
+  ast::Expression* parseIdentifier();
 
-  std::unique_ptr<ast::Expression> parseLiteral();
+  ast::Expression* parseLiteral();
 
-  std::string getIdentifierString();
+  support::InternedString getIdentifierString();
 
-  std::string expectIdentifier();
+  support::InternedString expectIdentifier();
 
   bool accept(Keyword keyword);
 
@@ -3,9 +3,10 @@
 
 namespace frontend {
 
-SourceFile::SourceFile(const char* path)
-: mFileReader{path},
-  mPosition{1, 1}
+SourceFile::SourceFile(SourceManager& source_manager, SourceManager::FileId file)
+: mSourceManager{source_manager},
+  mFile{file},
+  mFileReader{source_manager.reader(file)}
 {}
 
 support::UnicodeCharacter SourceFile::currentCharacter() const noexcept
@@ -15,18 +16,42 @@ support::UnicodeCharacter SourceFile::currentCharacter() const noexcept
 
 void SourceFile::next()
 {
-  if (mFileReader.currentCharacter() == '\n') {
-    mPosition.line++;
-    mPosition.column = 1;
-  }
-  else if (!mFileReader.currentCharacter().isEndOfFile())
-    mPosition.column++;
   mFileReader.next();
 }
 
-SourceFile::Position SourceFile::position() const noexcept
+std::string_view SourceFile::chunk() const noexcept
 {
-  return mPosition;
+  return mFileReader.chunk();
+}
+
+void SourceFile::skipChunk()
+{
+  mFileReader.skipChunk();
+}
+
+SourceLocation SourceFile::location() const noexcept
+{
+  return mSourceManager.location(mFile, mFileReader.offset());
+}
+
+SourcePosition SourceFile::position(SourceLocation location) const noexcept
+{
+  return mSourceManager.position(location);
+}
+
+SourcePosition SourceFile::position() const noexcept
+{
+  return position(location());
+}
+
+bool SourceFile::isStreamed() const noexcept
+{
+  return mFileReader.isStreamed();
+}
+
+std::string_view SourceFile::storeText(std::string_view text)
+{
+  return mSourceManager.storeText(text);
 }
 
 }
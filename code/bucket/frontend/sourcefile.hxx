@@ -2,34 +2,52 @@
 #define BUCKET_FRONTEND_SOURCEFILE_HXX
 
 #include "common.hxx"
+#include "frontend/sourcelocation.hxx"
+#include "frontend/sourcemanager.hxx"
 #include "support/unicodecharacter.hxx"
 #include "support/unicodefilereader.hxx"
+#include <string_view>
 
 namespace frontend {
 
+// Reads the characters of one file owned by a SourceManager.
 class SourceFile {
 
 public:
 
-  struct Position {
-    unsigned line, column;
-    constexpr Position() : line{0}, column{0} {}
-    constexpr Position(unsigned line, unsigned column) : line{line}, column{column} {}
-  };
-
-  explicit SourceFile(const char* path);
+  SourceFile(SourceManager& source_manager, SourceManager::FileId file);
 
   support::UnicodeCharacter currentCharacter() const noexcept;
 
   void next();
 
-  Position position() const noexcept;
+  // Raw access to the bytes in memory, for scanning without decoding every
+  // character (see UnicodeFileReader::chunk()). location() is the location of
+  // the first byte of chunk().
+  std::string_view chunk() const noexcept;
+
+  void skipChunk();
+
+  SourceLocation location() const noexcept;
+
+  SourcePosition position(SourceLocation location) const noexcept;
+
+  SourcePosition position() const noexcept;
+
+  // Returns true if the bytes of chunk() are overwritten by skipChunk();
+  // otherwise they stay valid as long as the source manager.
+  bool isStreamed() const noexcept;
+
+  // See SourceManager::storeText().
+  std::string_view storeText(std::string_view text);
 
 private:
 
-  support::UnicodeFileReader mFileReader;
+  SourceManager& mSourceManager;
+
+  SourceManager::FileId mFile;
 
-  Position mPosition;
+  support::UnicodeFileReader& mFileReader;
 
 };
 
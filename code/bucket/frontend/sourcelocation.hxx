@@ -0,0 +1,49 @@
+// sourcelocation.hxx
+// Defines the class SourceLocation, a handle to a byte of source code. Every
+// file loaded by the SourceManager occupies a range of one 32-bit location
+// space, so a location is a single integer that identifies both the file and
+// the offset within it. Resolving a location to a line and column is left to
+// the SourceManager, and only happens when a diagnostic needs it.
+
+#ifndef BUCKET_FRONTEND_SOURCELOCATION_HXX
+#define BUCKET_FRONTEND_SOURCELOCATION_HXX
+
+#include "common.hxx"
+#include <cstdint>
+
+namespace frontend {
+
+class SourceLocation {
+
+public:
+
+  // Constructs an invalid location, which belongs to no file.
+  constexpr SourceLocation() noexcept : mOffset{0} {}
+
+  constexpr explicit SourceLocation(std::uint32_t offset) noexcept : mOffset{offset} {}
+
+  constexpr std::uint32_t offset() const noexcept { return mOffset; }
+
+  constexpr bool isValid() const noexcept { return mOffset != 0; }
+
+  friend constexpr bool operator==(SourceLocation a, SourceLocation b) noexcept { return a.mOffset == b.mOffset; }
+  friend constexpr bool operator!=(SourceLocation a, SourceLocation b) noexcept { return a.mOffset != b.mOffset; }
+  friend constexpr bool operator<(SourceLocation a, SourceLocation b) noexcept { return a.mOffset < b.mOffset; }
+
+private:
+
+  std::uint32_t mOffset;
+
+};
+
+// A location resolved for display. Lines and columns are one-based; columns
+// are counted in code points.
+struct SourcePosition {
+  unsigned line, column;
+  constexpr SourcePosition() : line{0}, column{0} {}
+  constexpr SourcePosition(unsigned line, unsigned column) : line{line}, column{column} {}
+};
+
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "common.hxx"
+#include "frontend/sourcemanager.hxx"
+#include "support/concatenate.hxx"
+#include "support/fileloader.hxx"
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+namespace frontend {
+
+SourceManager::FileId SourceManager::addFile(const char* path)
+{
+  auto start = nextFileStart();
+  mReaders.emplace_back(path, support::UnicodeFileReader::SIZE_LIMIT - start);
+  mPaths.emplace_back(path);
+  mFileStarts.push_back(start);
+  return static_cast<FileId>(mReaders.size() - 1);
+}
+
+SourceManager::FileId SourceManager::addFile(std::string path, std::unique_ptr<unsigned char[]> contents, std::size_t size)
+{
+  auto start = nextFileStart();
+  mReaders.emplace_back(std::move(contents), size, support::UnicodeFileReader::SIZE_LIMIT - start);
+  mPaths.push_back(std::move(path));
+  mFileStarts.push_back(start);
+  return static_cast<FileId>(mReaders.size() - 1);
+}
+
+std::vector<SourceManager::FileId> SourceManager::addFiles(const std::vector<std::string>& paths, const std::function<void(std::size_t, FileId)>& loaded)
+{
+  std::vector<FileId> files(paths.size());
+  support::FileLoader loader{paths};
+  while (auto file = loader.next()) {
+    auto& path = paths[file->index];
+    try {
+      files[file->index] = addFile(path, std::move(file->contents), file->size);
+    } catch (std::runtime_error& e) {
+      throw std::runtime_error(support::concatenate(path.c_str(), ": ", static_cast<const char*>(e.what())));
+    }
+    if (loaded)
+      loaded(file->index, files[file->index]);
+  }
+  return files;
+}
+
+std::size_t SourceManager::fileCount() const noexcept
+{
+  return mReaders.size();
+}
+
+std::string_view SourceManager::path(FileId file) const noexcept
+{
+  return mPaths[file];
+}
+
+support::UnicodeFileReader& SourceManager::reader(FileId file) noexcept
+{
+  return mReaders[file];
+}
+
+SourceLocation SourceManager::location(FileId file, std::size_t offset) const noexcept
+{
+  return SourceLocation(mFileStarts[file] + static_cast<std::uint32_t>(offset));
+}
+
+SourceManager::FileId SourceManager::fileOf(SourceLocation location) const noexcept
+{
+  assert(location.isValid() && !mFileStarts.empty());
+  auto file = std::upper_bound(mFileStarts.begin(), mFileStarts.end(), location.offset());
+  return static_cast<FileId>(file - mFileStarts.begin() - 1);
+}
+
+SourcePosition SourceManager::position(SourceLocation location) const noexcept
+{
+  auto file = fileOf(location);
+  auto line_and_column = mReaders[file].lineAndColumn(location.offset() - mFileStarts[file]);
+  return SourcePosition(line_and_column.line, line_and_column.column);
+}
+
+std::string_view SourceManager::storeText(std::string_view text)
+{
+  std::lock_guard<std::mutex> lock{mTextMutex};
+  return mTextArena.store(text);
+}
+
+std::uint32_t SourceManager::nextFileStart() const
+{
+  if (mReaders.empty())
+    return 1;
+  if (mReaders.back().isStreaming())
+    throw std::runtime_error("unable to load another file while reading streamed input");
+
+  // every file's range includes the location just past its last byte, which
+  // is where its end-of-file token is
+  auto start = std::size_t{mFileStarts.back()} + mReaders.back().size() + 1;
+  if (start > support::UnicodeFileReader::SIZE_LIMIT)
+    throw std::runtime_error("source files larger than 4 GiB in total are not supported");
+  return static_cast<std::uint32_t>(start);
+}
+
+}
@@ -0,0 +1,97 @@
+// sourcemanager.hxx
+// Defines the class SourceManager, which loads and owns every source file of
+// a compilation. Each file is given its own range of one 32-bit location
+// space, in the order the files are added, so that a SourceLocation is enough
+// to find both the file and the byte it refers to. Line and column numbers
+// are resolved from a location on demand.
+
+#ifndef BUCKET_FRONTEND_SOURCEMANAGER_HXX
+#define BUCKET_FRONTEND_SOURCEMANAGER_HXX
+
+#include "common.hxx"
+#include "frontend/sourcelocation.hxx"
+#include "support/stringarena.hxx"
+#include "support/unicodefilereader.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace frontend {
+
+class SourceManager {
+
+public:
+
+  using FileId = std::uint32_t;
+
+  SourceManager() = default;
+
+  SourceManager(const SourceManager&) = delete;
+
+  SourceManager& operator=(const SourceManager&) = delete;
+
+  // Loads the file at 'path' (mapping it into memory where possible) and
+  // returns its id. Streamed input's size is unknown until it has been read,
+  // so no other file may be added while a streamed file is being read.
+  FileId addFile(const char* path);
+
+  // Adds a file whose contents are already in memory. 'path' only names the
+  // file in diagnostics.
+  FileId addFile(std::string path, std::unique_ptr<unsigned char[]> contents, std::size_t size);
+
+  // Loads many files at once, with their reads in flight concurrently (see
+  // support/fileloader.hxx). Files are added in the order their reads
+  // complete, and 'loaded' is called with the position of each file's path
+  // and its id as soon as it has been added, while the other files are still
+  // being read. Returns the ids of the files in the order of 'paths'. Unlike
+  // addFile(), the paths must name files; "-" is not standard input.
+  std::vector<FileId> addFiles(const std::vector<std::string>& paths, const std::function<void(std::size_t, FileId)>& loaded = nullptr);
+
+  std::size_t fileCount() const noexcept;
+
+  std::string_view path(FileId file) const noexcept;
+
+  support::UnicodeFileReader& reader(FileId file) noexcept;
+
+  // Returns the location of the byte at 'offset' within the file.
+  SourceLocation location(FileId file, std::size_t offset) const noexcept;
+
+  // Returns the file a valid location belongs to.
+  FileId fileOf(SourceLocation location) const noexcept;
+
+  SourcePosition position(SourceLocation location) const noexcept;
+
+  // Returns a copy of 'text' that lives as long as the source manager, for
+  // text that cannot refer to the files themselves (such as decoded string
+  // literals). Several threads may store text at the same time.
+  std::string_view storeText(std::string_view text);
+
+private:
+
+  // the deque keeps readers in place as files are added
+  std::deque<support::UnicodeFileReader> mReaders;
+
+  std::vector<std::string> mPaths;
+
+  // the location of the first byte of each file, in increasing order
+  std::vector<std::uint32_t> mFileStarts;
+
+  support::StringArena mTextArena;
+
+  std::mutex mTextMutex;
+
+  // the location the next file will start at; location zero is reserved for
+  // invalid locations
+  std::uint32_t nextFileStart() const;
+
+};
+
+}
+
+#endif
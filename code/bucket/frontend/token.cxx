@@ -61,119 +61,31 @@ std::string_view symbolToString(Symbol symbol) noexcept
   #pragma GCC diagnostic pop
 #endif
 
-Token Token::identifier(SourceFile::Position begin, SourceFile::Position end, std::string&& identifier)
+void print(std::ostream& stream, const Token& token, const LiteralTable& literals)
 {
-  return Token(begin, end, VariantType(std::in_place_index_t<1>(), std::move(identifier)));
-}
-
-Token Token::keyword(SourceFile::Position begin, SourceFile::Position end, Keyword keyword)
-{
-  return Token(begin, end, VariantType(std::in_place_index_t<2>(), keyword));
-}
-
-Token Token::symbol(SourceFile::Position begin, SourceFile::Position end, Symbol symbol)
-{
-  return Token(begin, end, VariantType(std::in_place_index_t<3>(), symbol));
-}
-
-Token Token::integerLiteral(SourceFile::Position begin, SourceFile::Position end, unsigned long integer_literal)
-{
-  return Token(begin, end, VariantType(std::in_place_index_t<4>(), integer_literal));
-}
-
-Token Token::realLiteral(SourceFile::Position begin, SourceFile::Position end, double real_literal)
-{
-  return Token(begin, end, VariantType(std::in_place_index_t<5>(), real_literal));
-}
-
-Token Token::stringLiteral(SourceFile::Position begin, SourceFile::Position end, std::string&& string_literal)
-{
-  return Token(begin, end, VariantType(std::in_place_index_t<6>(), std::move(string_literal)));
-}
-
-Token Token::characterLiteral(SourceFile::Position begin, SourceFile::Position end, support::UnicodeCharacter character_literal)
-{
-  return Token(begin, end, VariantType(std::in_place_index_t<7>(), character_literal));
-}
-
-Token Token::booleanLiteral(SourceFile::Position begin, SourceFile::Position end, bool boolean_literal)
-{
-  return Token(begin, end, VariantType(std::in_place_index_t<8>(), boolean_literal));
-}
-
-std::string* Token::getIdentifier()
-{
-  return std::get_if<1>(&value);
-}
+  if (auto identifier = token.getIdentifier())
+    stream << '<' << *identifier << '>';
 
-Keyword* Token::getKeyword()
-{
-  return std::get_if<2>(&value);
-}
+  else if (auto keyword = token.getKeyword())
+    stream << "<\033[1m" << keywordToString(*keyword) << "\033[0m>";
 
-Symbol* Token::getSymbol()
-{
-  return std::get_if<3>(&value);
-}
+  else if (auto symbol = token.getSymbol())
+    stream << "<\033[1m" << symbolToString(*symbol) << "\033[0m>";
 
-unsigned long* Token::getIntegerLiteral()
-{
-  return std::get_if<4>(&value);
-}
+  else if (auto integer_literal = token.getIntegerLiteral(literals))
+    stream << "<int: " << *integer_literal << '>';
 
-double* Token::getRealLiteral()
-{
-  return std::get_if<5>(&value);
-}
+  else if (auto real_literal = token.getRealLiteral(literals))
+    stream << "<real: " << *real_literal << '>';
 
-std::string* Token::getStringLiteral()
-{
-  return std::get_if<6>(&value);
-}
+  else if (auto string_literal = token.getStringLiteral(literals))
+    stream << "<\"" << *string_literal << "\">";
 
-support::UnicodeCharacter* Token::getCharacterLiteral()
-{
-  return std::get_if<7>(&value);
-}
+  else if (auto character_literal = token.getCharacterLiteral())
+    stream << "<'" << *character_literal << "'>";
 
-bool* Token::getBooleanLiteral()
-{
-  return std::get_if<8>(&value);
+  else if (auto boolean_literal = token.getBooleanLiteral())
+    stream << "<\033[31m" << (*boolean_literal ? "true" : "false") << "\033[0m>";
 }
 
-std::ostream& operator<<(std::ostream& stream, Token& token)
-{
-  if (auto identifier_ptr = token.getIdentifier())
-    stream << '<' << *identifier_ptr << '>';
-
-  else if (auto keyword_ptr = token.getKeyword())
-    stream << "<\033[1m" << keywordToString(*keyword_ptr) << "\033[0m>";
-
-  else if (auto symbol_ptr = token.getSymbol())
-    stream << "<\033[1m" << symbolToString(*symbol_ptr) << "\033[0m>";
-
-  else if (auto integer_literal_ptr = token.getIntegerLiteral())
-    stream << "<int: " << *integer_literal_ptr << '>';
-
-  else if (auto real_literal_ptr = token.getRealLiteral())
-    stream << "<real: " << *real_literal_ptr << '>';
-
-  else if (auto string_literal_ptr = token.getStringLiteral())
-    stream << "<\"" << *string_literal_ptr << "\">";
-
-  else if (auto character_literal_ptr = token.getCharacterLiteral())
-    stream << "<'" << *character_literal_ptr << "'>";
-
-  else if (auto boolean_literal_ptr = token.getBooleanLiteral())
-    stream << "<\033[31m" << (*boolean_literal_ptr ? "true" : "false") << "\033[0m>";
-
-  return stream;
-}
-
-Token::Token(SourceFile::Position begin, SourceFile::Position end, VariantType&& value)
-: begin(begin),
-  end(end),
-  value(std::move(value))
-{}
-
 }
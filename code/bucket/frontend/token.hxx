@@ -2,12 +2,15 @@
 #define BUCKET_FRONTEND_TOKEN_HXX
 
 #include "common.hxx"
-#include "frontend/sourcefile.hxx"
+#include "frontend/literaltable.hxx"
+#include "frontend/sourcelocation.hxx"
+#include "support/stringinterner.hxx"
 #include "support/unicodecharacter.hxx"
+#include <cstdint>
+#include <cstring>
+#include <optional>
 #include <ostream>
-#include <string>
 #include <string_view>
-#include <variant>
 
 namespace frontend {
 
@@ -26,53 +29,207 @@ enum class Symbol {
 
 std::string_view symbolToString(Symbol symbol) noexcept;
 
+enum class TokenKind : unsigned char {
+  Empty, Identifier, Keyword, Symbol, IntegerLiteral, RealLiteral,
+  StringLiteral, CharacterLiteral, BooleanLiteral
+};
+
+// A token is sixteen bytes: where it starts, its length, its kind, and a
+// 32-bit payload. The payload is the value itself for identifiers (their
+// interned id), keywords, symbols, character literals (their UTF-8 bytes)
+// and boolean literals. For integer, real and string literals it is an index
+// into the LiteralTable of whatever produced the token, the Lexer or the
+// TokenBuffer, and their getters take that table.
 class Token {
 
 public:
 
-  SourceFile::Position begin, end;
+  Token() noexcept;
+
+  static Token identifier(SourceLocation begin, SourceLocation end, support::InternedString identifier) noexcept;
+  static Token keyword(SourceLocation begin, SourceLocation end, Keyword keyword) noexcept;
+  static Token symbol(SourceLocation begin, SourceLocation end, Symbol symbol) noexcept;
+  static Token integerLiteral(SourceLocation begin, SourceLocation end, std::uint32_t literal) noexcept;
+  static Token realLiteral(SourceLocation begin, SourceLocation end, std::uint32_t literal) noexcept;
+  static Token stringLiteral(SourceLocation begin, SourceLocation end, std::uint32_t literal) noexcept;
+  static Token characterLiteral(SourceLocation begin, SourceLocation end, support::UnicodeCharacter character_literal) noexcept;
+  static Token booleanLiteral(SourceLocation begin, SourceLocation end, bool boolean_literal) noexcept;
+
+  // Puts a token back together from the parts returned by the accessors
+  // below.
+  static Token fromParts(TokenKind kind, SourceLocation begin, SourceLocation end, std::uint32_t payload) noexcept;
+
+  SourceLocation begin() const noexcept;
+  SourceLocation end() const noexcept;
+  TokenKind kind() const noexcept;
+  std::uint32_t payload() const noexcept;
+
+  std::optional<support::InternedString> getIdentifier() const noexcept;
+  std::optional<Keyword> getKeyword() const noexcept;
+  std::optional<Symbol> getSymbol() const noexcept;
+  std::optional<unsigned long> getIntegerLiteral(const LiteralTable& literals) const noexcept;
+  std::optional<double> getRealLiteral(const LiteralTable& literals) const noexcept;
+  std::optional<std::string_view> getStringLiteral(const LiteralTable& literals) const noexcept;
+  std::optional<support::UnicodeCharacter> getCharacterLiteral() const noexcept;
+  std::optional<bool> getBooleanLiteral() const noexcept;
 
-  Token() = default;
+private:
 
-  static Token identifier(SourceFile::Position begin, SourceFile::Position end, std::string&& identifier);
-  static Token keyword(SourceFile::Position begin, SourceFile::Position end, Keyword keyword);
-  static Token symbol(SourceFile::Position begin, SourceFile::Position end, Symbol symbol);
-  static Token integerLiteral(SourceFile::Position begin, SourceFile::Position end, unsigned long integer_literal);
-  static Token realLiteral(SourceFile::Position begin, SourceFile::Position end, double real_literal);
-  static Token stringLiteral(SourceFile::Position begin, SourceFile::Position end, std::string&& string_literal);
-  static Token characterLiteral(SourceFile::Position begin, SourceFile::Position end, support::UnicodeCharacter character_literal);
-  static Token booleanLiteral(SourceFile::Position begin, SourceFile::Position end, bool boolean_literal);
+  SourceLocation mBegin;
 
-  std::string* getIdentifier();
-  Keyword* getKeyword();
-  Symbol* getSymbol();
-  unsigned long* getIntegerLiteral();
-  double* getRealLiteral();
-  std::string* getStringLiteral();
-  support::UnicodeCharacter* getCharacterLiteral();
-  bool* getBooleanLiteral();
+  std::uint32_t mLength;
 
-  friend std::ostream& operator<<(std::ostream& stream, Token& token);
+  std::uint32_t mPayload;
 
-private:
+  TokenKind mKind;
 
-  std::variant<
-    std::monostate,             // Empty
-    std::string,                // Identifier
-    Keyword,                    // Keyword
-    Symbol,                     // Symbol
-    unsigned long,              // Integer Literal
-    double,                     // Real Literal
-    std::string,                // String Literal
-    support::UnicodeCharacter,  // Character Literal
-    bool                        // Boolean Literal
-  > value;
+  Token(TokenKind kind, SourceLocation begin, SourceLocation end, std::uint32_t payload) noexcept;
 
-  using VariantType = decltype(value);
+};
 
-  Token(SourceFile::Position begin, SourceFile::Position end, VariantType&& value);
+static_assert(sizeof(Token) <= 16);
 
-};
+// Writes the token as --lex shows it; its literals are in 'literals'.
+void print(std::ostream& stream, const Token& token, const LiteralTable& literals);
+
+inline Token::Token() noexcept
+: Token(TokenKind::Empty, SourceLocation(), SourceLocation(), 0)
+{}
+
+inline Token Token::identifier(SourceLocation begin, SourceLocation end, support::InternedString identifier) noexcept
+{
+  return Token(TokenKind::Identifier, begin, end, identifier.id());
+}
+
+inline Token Token::keyword(SourceLocation begin, SourceLocation end, Keyword keyword) noexcept
+{
+  return Token(TokenKind::Keyword, begin, end, static_cast<std::uint32_t>(keyword));
+}
+
+inline Token Token::symbol(SourceLocation begin, SourceLocation end, Symbol symbol) noexcept
+{
+  return Token(TokenKind::Symbol, begin, end, static_cast<std::uint32_t>(symbol));
+}
+
+inline Token Token::integerLiteral(SourceLocation begin, SourceLocation end, std::uint32_t literal) noexcept
+{
+  return Token(TokenKind::IntegerLiteral, begin, end, literal);
+}
+
+inline Token Token::realLiteral(SourceLocation begin, SourceLocation end, std::uint32_t literal) noexcept
+{
+  return Token(TokenKind::RealLiteral, begin, end, literal);
+}
+
+inline Token Token::stringLiteral(SourceLocation begin, SourceLocation end, std::uint32_t literal) noexcept
+{
+  return Token(TokenKind::StringLiteral, begin, end, literal);
+}
+
+inline Token Token::characterLiteral(SourceLocation begin, SourceLocation end, support::UnicodeCharacter character_literal) noexcept
+{
+  // the payload is the character's UTF-8 encoding, which is at most four
+  // bytes
+  auto bytes = character_literal.bytes();
+  std::uint32_t payload = 0;
+  std::memcpy(&payload, bytes.data(), bytes.size());
+  return Token(TokenKind::CharacterLiteral, begin, end, payload);
+}
+
+inline Token Token::booleanLiteral(SourceLocation begin, SourceLocation end, bool boolean_literal) noexcept
+{
+  return Token(TokenKind::BooleanLiteral, begin, end, boolean_literal);
+}
+
+inline Token Token::fromParts(TokenKind kind, SourceLocation begin, SourceLocation end, std::uint32_t payload) noexcept
+{
+  return Token(kind, begin, end, payload);
+}
+
+inline SourceLocation Token::begin() const noexcept
+{
+  return mBegin;
+}
+
+inline SourceLocation Token::end() const noexcept
+{
+  return SourceLocation(mBegin.offset() + mLength);
+}
+
+inline TokenKind Token::kind() const noexcept
+{
+  return mKind;
+}
+
+inline std::uint32_t Token::payload() const noexcept
+{
+  return mPayload;
+}
+
+inline std::optional<support::InternedString> Token::getIdentifier() const noexcept
+{
+  if (mKind != TokenKind::Identifier)
+    return std::nullopt;
+  return support::InternedString::fromId(mPayload);
+}
+
+inline std::optional<Keyword> Token::getKeyword() const noexcept
+{
+  if (mKind != TokenKind::Keyword)
+    return std::nullopt;
+  return static_cast<Keyword>(mPayload);
+}
+
+inline std::optional<Symbol> Token::getSymbol() const noexcept
+{
+  if (mKind != TokenKind::Symbol)
+    return std::nullopt;
+  return static_cast<Symbol>(mPayload);
+}
+
+inline std::optional<unsigned long> Token::getIntegerLiteral(const LiteralTable& literals) const noexcept
+{
+  if (mKind != TokenKind::IntegerLiteral)
+    return std::nullopt;
+  return literals.integer(mPayload);
+}
+
+inline std::optional<double> Token::getRealLiteral(const LiteralTable& literals) const noexcept
+{
+  if (mKind != TokenKind::RealLiteral)
+    return std::nullopt;
+  return literals.real(mPayload);
+}
+
+inline std::optional<std::string_view> Token::getStringLiteral(const LiteralTable& literals) const noexcept
+{
+  if (mKind != TokenKind::StringLiteral)
+    return std::nullopt;
+  return literals.string(mPayload);
+}
+
+inline std::optional<support::UnicodeCharacter> Token::getCharacterLiteral() const noexcept
+{
+  if (mKind != TokenKind::CharacterLiteral)
+    return std::nullopt;
+  unsigned char bytes[4];
+  std::memcpy(bytes, &mPayload, sizeof(bytes));
+  return support::UnicodeCharacter::fromValidUtf8(bytes);
+}
+
+inline std::optional<bool> Token::getBooleanLiteral() const noexcept
+{
+  if (mKind != TokenKind::BooleanLiteral)
+    return std::nullopt;
+  return mPayload != 0;
+}
+
+inline Token::Token(TokenKind kind, SourceLocation begin, SourceLocation end, std::uint32_t payload) noexcept
+: mBegin(begin),
+  mLength(end.offset() - begin.offset()),
+  mPayload(payload),
+  mKind(kind)
+{}
 
 }
 
@@ -0,0 +1,289 @@
+#include "common.hxx"
+#include "frontend/tokenbuffer.hxx"
+#include "frontend/lexer.hxx"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace frontend {
+
+namespace {
+
+// Below this many bytes a part is lexed in about the time it takes to start a
+// thread for it.
+constexpr std::size_t MIN_PART_SIZE = 256 << 10;
+
+constexpr std::uint32_t NO_STOP = std::numeric_limits<std::uint32_t>::max();
+
+// Returns where each part of 'text' starts: at 'start', then after the first
+// newline at or past each even share of the text. Fewer parts are returned if
+// the newlines run out.
+std::vector<SourceLocation> splitAtNewlines(std::string_view text, SourceLocation start, std::size_t part_count)
+{
+  std::vector<SourceLocation> starts{start};
+  std::size_t previous = 0;
+  for (std::size_t i = 1; i != part_count; ++i) {
+    auto newline = text.find('\n', std::max(text.size() / part_count * i, previous));
+    if (newline == std::string_view::npos || newline + 1 == text.size())
+      break;
+    previous = newline + 1;
+    starts.push_back(SourceLocation(start.offset() + static_cast<std::uint32_t>(previous)));
+  }
+  return starts;
+}
+
+}
+
+TokenBuffer::TokenBuffer(SourceManager& source_manager, SourceManager::FileId file, unsigned threads)
+{
+  auto& reader = source_manager.reader(file);
+  auto text = reader.chunk();
+  auto part_count = std::min<std::size_t>(threads, text.size() / MIN_PART_SIZE);
+  if (reader.isStreamed() || part_count <= 1) {
+    reserve(reader.size());
+    lex(source_manager, file, SourceLocation(), NO_STOP);
+    return;
+  }
+
+  auto starts = splitAtNewlines(text, source_manager.location(file, reader.offset()), part_count);
+  auto end = source_manager.location(file, reader.offset() + text.size());
+  std::vector<TokenBuffer> parts(starts.size(), TokenBuffer());
+  auto lexPart = [&](std::size_t i) {
+    auto stop = i + 1 != starts.size() ? starts[i + 1] : end;
+    parts[i].reserve(stop.offset() - starts[i].offset());
+    parts[i].lex(source_manager, file, starts[i], i + 1 != starts.size() ? stop.offset() : NO_STOP);
+  };
+  {
+    std::vector<std::thread> workers;
+    workers.reserve(parts.size() - 1);
+    for (std::size_t i = 1; i != parts.size(); ++i) {
+      try {
+        workers.emplace_back(lexPart, i);
+      } catch (const std::system_error&) {
+        // no more threads to be had
+        lexPart(i);
+      }
+    }
+    lexPart(0);
+    for (auto& worker : workers)
+      worker.join();
+  }
+
+  // Each part but the first was lexed on the guess that the tokens before it
+  // end with the newline right before its start. Where they do not, the part
+  // is lexed again by carrying on from the end of the last token.
+  reserve(end.offset() - starts[0].offset());
+  std::optional<Lexer> lexer;
+  for (std::size_t i = 0; i != parts.size(); ++i) {
+    auto resume = mEnds.empty() ? starts[0] : mEnds.back();
+    if (resume == starts[i]) {
+      lexer.reset();
+      append(parts[i]);
+      if (mError)
+        return;
+      continue;
+    }
+    try {
+      if (!lexer)
+        lexer.emplace(source_manager, file, resume);
+      appendUntil(*lexer, i + 1 != starts.size() ? starts[i + 1].offset() : NO_STOP);
+    } catch (...) {
+      mError = std::current_exception();
+      return;
+    }
+  }
+}
+
+std::size_t TokenBuffer::size() const noexcept
+{
+  return mKinds.size();
+}
+
+void TokenBuffer::throwIfIncomplete() const
+{
+  if (mError)
+    std::rethrow_exception(mError);
+}
+
+TokenKind TokenBuffer::kind(std::size_t index) const noexcept
+{
+  return mKinds[index];
+}
+
+SourceLocation TokenBuffer::begin(std::size_t index) const noexcept
+{
+  return mBegins[index];
+}
+
+SourceLocation TokenBuffer::end(std::size_t index) const noexcept
+{
+  return mEnds[index];
+}
+
+support::InternedString TokenBuffer::identifier(std::size_t index) const noexcept
+{
+  assert(mKinds[index] == TokenKind::Identifier);
+  return support::InternedString::fromId(mPayloads[index]);
+}
+
+Keyword TokenBuffer::keyword(std::size_t index) const noexcept
+{
+  assert(mKinds[index] == TokenKind::Keyword);
+  return static_cast<Keyword>(mPayloads[index]);
+}
+
+Symbol TokenBuffer::symbol(std::size_t index) const noexcept
+{
+  assert(mKinds[index] == TokenKind::Symbol);
+  return static_cast<Symbol>(mPayloads[index]);
+}
+
+unsigned long TokenBuffer::integerLiteral(std::size_t index) const noexcept
+{
+  assert(mKinds[index] == TokenKind::IntegerLiteral);
+  return mLiterals.integer(mPayloads[index]);
+}
+
+double TokenBuffer::realLiteral(std::size_t index) const noexcept
+{
+  assert(mKinds[index] == TokenKind::RealLiteral);
+  return mLiterals.real(mPayloads[index]);
+}
+
+std::string_view TokenBuffer::stringLiteral(std::size_t index) const noexcept
+{
+  assert(mKinds[index] == TokenKind::StringLiteral);
+  return mLiterals.string(mPayloads[index]);
+}
+
+support::UnicodeCharacter TokenBuffer::characterLiteral(std::size_t index) const noexcept
+{
+  assert(mKinds[index] == TokenKind::CharacterLiteral);
+  return *token(index).getCharacterLiteral();
+}
+
+bool TokenBuffer::booleanLiteral(std::size_t index) const noexcept
+{
+  assert(mKinds[index] == TokenKind::BooleanLiteral);
+  return mPayloads[index];
+}
+
+Token TokenBuffer::token(std::size_t index) const noexcept
+{
+  return Token::fromParts(mKinds[index], mBegins[index], mEnds[index], mPayloads[index]);
+}
+
+const LiteralTable& TokenBuffer::literals() const noexcept
+{
+  return mLiterals;
+}
+
+void TokenBuffer::reserve(std::size_t bytes)
+{
+  // a guess from the size of the source, to spare most of the regrowing
+  auto expected_tokens = bytes / 4 + 1;
+  mKinds.reserve(expected_tokens);
+  mBegins.reserve(expected_tokens);
+  mEnds.reserve(expected_tokens);
+  mPayloads.reserve(expected_tokens);
+}
+
+void TokenBuffer::lex(SourceManager& source_manager, SourceManager::FileId file, SourceLocation start, std::uint32_t stop)
+{
+  assert(mKinds.empty());
+  std::optional<Lexer> lexer;
+  try {
+    if (start.isValid())
+      lexer.emplace(source_manager, file, start);
+    else
+      lexer.emplace(source_manager, file);
+    while (true) {
+      auto& token = lexer->currentToken();
+      if (token.begin().offset() >= stop)
+        break;
+      append(token);
+      if (auto symbol = token.getSymbol(); symbol && *symbol == Symbol::EndOfFile)
+        break;
+      lexer->next();
+    }
+  } catch (...) {
+    mError = std::current_exception();
+  }
+  if (lexer)
+    mLiterals = lexer->takeLiterals();
+}
+
+void TokenBuffer::append(const Token& token)
+{
+  mKinds.push_back(token.kind());
+  mBegins.push_back(token.begin());
+  mEnds.push_back(token.end());
+  mPayloads.push_back(token.payload());
+}
+
+void TokenBuffer::append(const Token& token, const LiteralTable& literals)
+{
+  auto payload = token.payload();
+  switch (token.kind()) {
+    case TokenKind::IntegerLiteral:
+      payload = mLiterals.addInteger(literals.integer(payload));
+      break;
+    case TokenKind::RealLiteral:
+      payload = mLiterals.addReal(literals.real(payload));
+      break;
+    case TokenKind::StringLiteral:
+      payload = mLiterals.addString(literals.string(payload));
+      break;
+    default:
+      break;
+  }
+  append(Token::fromParts(token.kind(), token.begin(), token.end(), payload));
+}
+
+void TokenBuffer::appendUntil(Lexer& lexer, std::uint32_t stop)
+{
+  while (true) {
+    auto& token = lexer.currentToken();
+    if (token.begin().offset() >= stop)
+      return;
+    append(token, lexer.literals());
+    if (auto symbol = token.getSymbol(); symbol && *symbol == Symbol::EndOfFile)
+      return;
+    lexer.next();
+  }
+}
+
+void TokenBuffer::append(const TokenBuffer& part)
+{
+  auto first = mKinds.size();
+  mKinds.insert(mKinds.end(), part.mKinds.begin(), part.mKinds.end());
+  mBegins.insert(mBegins.end(), part.mBegins.begin(), part.mBegins.end());
+  mEnds.insert(mEnds.end(), part.mEnds.begin(), part.mEnds.end());
+  mPayloads.insert(mPayloads.end(), part.mPayloads.begin(), part.mPayloads.end());
+  auto indices = mLiterals.append(part.mLiterals);
+
+  // the literals' indices are now past those of the tokens before
+  for (auto i = first; i != mKinds.size(); ++i) {
+    switch (mKinds[i]) {
+      case TokenKind::IntegerLiteral:
+        mPayloads[i] += indices.integers;
+        break;
+      case TokenKind::RealLiteral:
+        mPayloads[i] += indices.reals;
+        break;
+      case TokenKind::StringLiteral:
+        mPayloads[i] += indices.strings;
+        break;
+      default:
+        break;
+    }
+  }
+  mError = part.mError;
+}
+
+}
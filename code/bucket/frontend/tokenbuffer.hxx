@@ -0,0 +1,131 @@
+// tokenbuffer.hxx
+// Defines the class TokenBuffer, which lexes a whole file up front and keeps
+// its tokens in parallel arrays: one byte for the kind, the begin and end
+// locations, and the token's 32-bit payload (see frontend/token.hxx), whose
+// integer, real and string literals are indexed into the buffer's own
+// LiteralTable. Any token can be looked at by index, so
+// the parser has unlimited lookahead, and a finished buffer holds no
+// references to the lexer, so it can be kept or handed to another thread.
+// A large file can be lexed by several threads at once, each taking a part
+// of it.
+
+#ifndef BUCKET_FRONTEND_TOKENBUFFER_HXX
+#define BUCKET_FRONTEND_TOKENBUFFER_HXX
+
+#include "common.hxx"
+#include "frontend/literaltable.hxx"
+#include "frontend/sourcelocation.hxx"
+#include "frontend/sourcemanager.hxx"
+#include "frontend/token.hxx"
+#include "support/stringinterner.hxx"
+#include "support/unicodecharacter.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string_view>
+#include <vector>
+
+namespace frontend {
+
+class Lexer;
+
+class TokenBuffer {
+
+public:
+
+  // Lexes the file up to and including its end-of-file token. If the lexer
+  // fails, the buffer holds the tokens before the failure and the error is
+  // kept for throwIfIncomplete(), so that it is reported when the parser gets
+  // that far rather than up front.
+  //
+  // With more than one thread, a file that is in memory and large enough is
+  // split after newlines into parts that are lexed at the same time, each as
+  // if no token, comment or string literal were open where it starts. When
+  // that turns out to be wrong (a block comment or string literal runs across
+  // the split), the lexing of the part before is carried on over the next
+  // part instead, until it ends right where a part starts again. The tokens
+  // and the error are the same as with one thread.
+  TokenBuffer(SourceManager& source_manager, SourceManager::FileId file, unsigned threads = 1);
+
+  // Returns the number of tokens, the end-of-file token included.
+  std::size_t size() const noexcept;
+
+  // Throws the lexer's error if it failed before the end of the file.
+  void throwIfIncomplete() const;
+
+  // The accessors below take the index of a token; the payload accessors
+  // require the token to be of the matching kind.
+
+  TokenKind kind(std::size_t index) const noexcept;
+
+  SourceLocation begin(std::size_t index) const noexcept;
+
+  SourceLocation end(std::size_t index) const noexcept;
+
+  support::InternedString identifier(std::size_t index) const noexcept;
+
+  Keyword keyword(std::size_t index) const noexcept;
+
+  Symbol symbol(std::size_t index) const noexcept;
+
+  unsigned long integerLiteral(std::size_t index) const noexcept;
+
+  double realLiteral(std::size_t index) const noexcept;
+
+  std::string_view stringLiteral(std::size_t index) const noexcept;
+
+  support::UnicodeCharacter characterLiteral(std::size_t index) const noexcept;
+
+  bool booleanLiteral(std::size_t index) const noexcept;
+
+  // Puts the token at 'index' back together, for printing; its literals are
+  // in literals().
+  Token token(std::size_t index) const noexcept;
+
+  const LiteralTable& literals() const noexcept;
+
+private:
+
+  std::vector<TokenKind> mKinds;
+
+  std::vector<SourceLocation> mBegins;
+
+  std::vector<SourceLocation> mEnds;
+
+  std::vector<std::uint32_t> mPayloads;
+
+  LiteralTable mLiterals;
+
+  std::exception_ptr mError;
+
+  TokenBuffer() = default;
+
+  // Reserves room for the tokens of 'bytes' bytes of source, by a guess.
+  void reserve(std::size_t bytes);
+
+  // Lexes into an empty buffer from 'start' (or from where the file's reader
+  // is, if 'start' is invalid) up to the end-of-file token or the first token
+  // that begins at or after 'stop'. The lexer's literal table becomes the
+  // buffer's, so the tokens are stored as they are.
+  void lex(SourceManager& source_manager, SourceManager::FileId file, SourceLocation start, std::uint32_t stop);
+
+  // Appends a token whose literals are in the buffer's own table.
+  void append(const Token& token);
+
+  // Appends a token whose literals are in 'literals', copying them.
+  void append(const Token& token, const LiteralTable& literals);
+
+  // Appends the lexer's tokens up to the end-of-file token, or up to the
+  // first one that begins at or after 'stop', which is left unappended as
+  // the lexer's current token.
+  void appendUntil(Lexer& lexer, std::uint32_t stop);
+
+  // Appends the tokens of a buffer for a part of the same file, and takes
+  // over its error.
+  void append(const TokenBuffer& part);
+
+};
+
+}
+
+#endif
@@ -0,0 +1,35 @@
+#include "common.hxx"
+#include "frontend/tokencursor.hxx"
+
+namespace frontend {
+
+TokenCursor::TokenCursor(SourceManager& source_manager, SourceManager::FileId file, unsigned threads)
+: mIndex(0)
+{
+  if (source_manager.reader(file).isStreamed()) {
+    mLexer.emplace(source_manager, file);
+    mToken = mLexer->currentToken();
+    return;
+  }
+  mBuffer.emplace(source_manager, file, threads);
+  if (mBuffer->size() == 0)
+    mBuffer->throwIfIncomplete();
+}
+
+void TokenCursor::advance()
+{
+  if (mLexer) {
+    if (auto symbol = mToken.getSymbol(); symbol && *symbol == Symbol::EndOfFile)
+      return;
+    mLexer->next();
+    mToken = mLexer->currentToken();
+    return;
+  }
+  if (mIndex + 1 == mBuffer->size()) {
+    mBuffer->throwIfIncomplete();
+    return;
+  }
+  ++mIndex;
+}
+
+}
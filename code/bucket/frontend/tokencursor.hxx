@@ -0,0 +1,143 @@
+// tokencursor.hxx
+// Defines the class TokenCursor, which is the parser's place in the tokens
+// of a file. A file that is in memory is lexed up front into a TokenBuffer
+// (see frontend/tokenbuffer.hxx), and the cursor steps through it by index.
+// A streamed file is lexed one token at a time as the cursor moves, so that
+// parsing keeps pace with input that is still arriving instead of waiting
+// for all of it.
+
+#ifndef BUCKET_FRONTEND_TOKENCURSOR_HXX
+#define BUCKET_FRONTEND_TOKENCURSOR_HXX
+
+#include "common.hxx"
+#include "frontend/lexer.hxx"
+#include "frontend/literaltable.hxx"
+#include "frontend/sourcelocation.hxx"
+#include "frontend/sourcemanager.hxx"
+#include "frontend/token.hxx"
+#include "frontend/tokenbuffer.hxx"
+#include "support/stringinterner.hxx"
+#include "support/unicodecharacter.hxx"
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace frontend {
+
+class TokenCursor {
+
+public:
+
+  // Starts at the first token of the file. 'threads' is passed on to the
+  // TokenBuffer of a file that is not streamed.
+  TokenCursor(SourceManager& source_manager, SourceManager::FileId file, unsigned threads = 1);
+
+  // Moves to the next token; the end-of-file token is never moved past.
+  // Throws the lexer's error on reaching the point where lexing failed.
+  void advance();
+
+  // The accessors below look at the current token; the payload accessors
+  // require it to be of the matching kind.
+
+  TokenKind kind() const noexcept;
+
+  SourceLocation begin() const noexcept;
+
+  support::InternedString identifier() const noexcept;
+
+  Keyword keyword() const noexcept;
+
+  Symbol symbol() const noexcept;
+
+  unsigned long integerLiteral() const noexcept;
+
+  double realLiteral() const noexcept;
+
+  std::string_view stringLiteral() const noexcept;
+
+  support::UnicodeCharacter characterLiteral() const noexcept;
+
+  bool booleanLiteral() const noexcept;
+
+  // The current token, for printing; its literals are in literals().
+  Token token() const noexcept;
+
+  const LiteralTable& literals() const noexcept;
+
+private:
+
+  // set for a file in memory
+  std::optional<TokenBuffer> mBuffer;
+
+  std::size_t mIndex;
+
+  // set for a streamed file, with a copy of its current token
+  std::optional<Lexer> mLexer;
+
+  Token mToken;
+
+};
+
+inline TokenKind TokenCursor::kind() const noexcept
+{
+  return mBuffer ? mBuffer->kind(mIndex) : mToken.kind();
+}
+
+inline SourceLocation TokenCursor::begin() const noexcept
+{
+  return mBuffer ? mBuffer->begin(mIndex) : mToken.begin();
+}
+
+inline support::InternedString TokenCursor::identifier() const noexcept
+{
+  return mBuffer ? mBuffer->identifier(mIndex) : *mToken.getIdentifier();
+}
+
+inline Keyword TokenCursor::keyword() const noexcept
+{
+  return mBuffer ? mBuffer->keyword(mIndex) : *mToken.getKeyword();
+}
+
+inline Symbol TokenCursor::symbol() const noexcept
+{
+  return mBuffer ? mBuffer->symbol(mIndex) : *mToken.getSymbol();
+}
+
+inline unsigned long TokenCursor::integerLiteral() const noexcept
+{
+  return mBuffer ? mBuffer->integerLiteral(mIndex) : *mToken.getIntegerLiteral(mLexer->literals());
+}
+
+inline double TokenCursor::realLiteral() const noexcept
+{
+  return mBuffer ? mBuffer->realLiteral(mIndex) : *mToken.getRealLiteral(mLexer->literals());
+}
+
+inline std::string_view TokenCursor::stringLiteral() const noexcept
+{
+  return mBuffer ? mBuffer->stringLiteral(mIndex) : *mToken.getStringLiteral(mLexer->literals());
+}
+
+inline support::UnicodeCharacter TokenCursor::characterLiteral() const noexcept
+{
+  return mBuffer ? mBuffer->characterLiteral(mIndex) : *mToken.getCharacterLiteral();
+}
+
+inline bool TokenCursor::booleanLiteral() const noexcept
+{
+  return mBuffer ? mBuffer->booleanLiteral(mIndex) : *mToken.getBooleanLiteral();
+}
+
+inline Token TokenCursor::token() const noexcept
+{
+  return mBuffer ? mBuffer->token(mIndex) : mToken;
+}
+
+inline const LiteralTable& TokenCursor::literals() const noexcept
+{
+  return mBuffer ? mBuffer->literals() : mLexer->literals();
+}
+
+}
+
+#endif
@@ -1,75 +1,221 @@
 #include "common.hxx"
 #include "support/concatenate.hxx"
+#include "abstract_syntax_tree/context.hxx"
+#include "abstract_syntax_tree/flat_tree.hxx"
 #include "compiler_objects/module.hxx"
 #include "frontend/lexer.hxx"
 #include "frontend/parser.hxx"
 #include "frontend/sourcefile.hxx"
+#include "frontend/sourcemanager.hxx"
 #include "frontend/token.hxx"
+#include "frontend/tokenbuffer.hxx"
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <exception>
 #include <iostream>
+#include <optional>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 
-static void read(const char* path)
+// Calls 'use' with each file, in the order of 'paths'. A single file is
+// mapped, or streamed if it cannot be. Several files are loaded concurrently,
+// and each is used as soon as it and the files before it have been loaded,
+// while the rest are still being read.
+template <typename Use>
+static void forEachSourceFile(frontend::SourceManager& source_manager, const std::vector<std::string>& paths, Use use)
 {
-  frontend::SourceFile source_file{path};
-  while (!source_file.currentCharacter().isEndOfFile()) {
-    std::cout << source_file.currentCharacter();
-    source_file.next();
+  if (paths.size() == 1) {
+    use(source_manager.addFile(paths[0].c_str()));
+    return;
+  }
+  std::vector<std::optional<frontend::SourceManager::FileId>> loaded(paths.size());
+  std::size_t next = 0;
+  source_manager.addFiles(paths, [&](std::size_t index, frontend::SourceManager::FileId file) {
+    loaded[index] = file;
+    for (; next != paths.size() && loaded[next]; ++next)
+      use(*loaded[next]);
+  });
+}
+
+
+struct ReadStatistics {
+  std::size_t bytes = 0;
+  std::size_t code_points = 0;
+  std::size_t lines = 0;
+};
+
+
+static void countChunk(ReadStatistics& statistics, std::string_view chunk, bool& at_line_start)
+{
+  std::size_t code_points = 0, newlines = 0;
+  for (auto c : chunk) {
+    code_points += (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+    newlines += c == '\n';
   }
+  statistics.bytes += chunk.size();
+  statistics.code_points += code_points;
+  statistics.lines += newlines;
+  if (!chunk.empty())
+    at_line_start = chunk.back() == '\n';
 }
 
 
-static void lex(const char* path)
+// Writes the contents of the files to standard output, one chunk at a time.
+// Input is validated as it is loaded, so no decoding is needed to copy it.
+static void read(const std::vector<std::string>& paths, bool print_statistics)
 {
-  frontend::Lexer lexer{path};
-  while (!(lexer.currentToken().getSymbol() && *lexer.currentToken().getSymbol() == frontend::Symbol::EndOfFile)) {
-    std::cout << lexer.currentToken();
-    lexer.next();
+  auto start = std::chrono::steady_clock::now();
+  ReadStatistics statistics;
+  frontend::SourceManager source_manager;
+  forEachSourceFile(source_manager, paths, [&](frontend::SourceManager::FileId file) {
+    auto& reader = source_manager.reader(file);
+    bool at_line_start = true;
+    for (auto chunk = reader.chunk(); !chunk.empty(); reader.skipChunk(), chunk = reader.chunk()) {
+      std::cout.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+      if (print_statistics)
+        countChunk(statistics, chunk, at_line_start);
+    }
+    // a last line without a newline still counts
+    statistics.lines += !at_line_start;
+  });
+  std::cout.flush();
+  auto stop = std::chrono::steady_clock::now();
+
+  if (print_statistics) {
+    std::chrono::duration<double> seconds = stop - start;
+    std::cerr << "bytes:       " << statistics.bytes << '\n'
+              << "code points: " << statistics.code_points << '\n'
+              << "lines:       " << statistics.lines << '\n'
+              << "time:        " << seconds.count() * 1e3 << " ms\n"
+              << "throughput:  " << static_cast<double>(statistics.bytes) / seconds.count() / 1e6 << " MB/s\n";
   }
 }
 
 
-static void parse(const char* path)
+// With --parallel, large files are lexed by one thread per core (see
+// frontend/tokenbuffer.hxx).
+static unsigned lexerThreads(bool parallel)
+{
+  return parallel ? std::max(1u, std::thread::hardware_concurrency()) : 1;
+}
+
+
+static void lex(const std::vector<std::string>& paths, bool parallel)
+{
+  frontend::SourceManager source_manager;
+  forEachSourceFile(source_manager, paths, [&](frontend::SourceManager::FileId file) {
+    if (parallel && !source_manager.reader(file).isStreamed()) {
+      frontend::TokenBuffer tokens{source_manager, file, lexerThreads(parallel)};
+      for (std::size_t i = 0; i != tokens.size(); ++i) {
+        if (tokens.kind(i) == frontend::TokenKind::Symbol && tokens.symbol(i) == frontend::Symbol::EndOfFile)
+          break;
+        frontend::print(std::cout, tokens.token(i), tokens.literals());
+      }
+      tokens.throwIfIncomplete();
+      return;
+    }
+    frontend::Lexer lexer{source_manager, file};
+    while (!(lexer.currentToken().getSymbol() && *lexer.currentToken().getSymbol() == frontend::Symbol::EndOfFile)) {
+      frontend::print(std::cout, lexer.currentToken(), lexer.literals());
+      lexer.next();
+    }
+  });
+}
+
+
+// Options of --parse and --compile, which come before the path.
+struct ParseOptions {
+  bool parallel = false;
+  // the tree is converted to an ast::flat::Tree, which is printed or compiled
+  // instead
+  bool flat = false;
+};
+
+
+static void parse(const char* path, ParseOptions options)
 {
-  std::unique_ptr<ast::Class> program;
+  frontend::SourceManager source_manager;
+  ast::Context context;
+  ast::Class* program;
   {
-    frontend::Parser parser{path};
+    frontend::Parser parser{context, source_manager, source_manager.addFile(path), lexerThreads(options.parallel)};
     program = parser.parse();
   }
-  std::cout << *program;
+  if (options.flat)
+    std::cout << ast::flat::Tree(program);
+  else
+    std::cout << *program;
 }
 
 
-static void compile(const char* path)
+static void compile(const char* path, ParseOptions options)
 {
-  std::unique_ptr<ast::Class> program;
+  frontend::SourceManager source_manager;
+  ast::Context context;
+  ast::Class* program;
   {
-    frontend::Parser parser{path};
+    frontend::Parser parser{context, source_manager, source_manager.addFile(path), lexerThreads(options.parallel)};
     program = parser.parse();
   }
-  cobjs::Module module{program.get()};
-  module.init(program.get());
+  if (options.flat) {
+    ast::flat::Tree tree{program};
+    cobjs::Module module{tree};
+    module.init(tree, tree.get<ast::flat::Class>(tree.root()));
+    return;
+  }
+  cobjs::Module module{program};
+  module.init(program);
 }
 
 
-static void main_with_exceptions(int argc, char* argv[])
+// Reads the options from argv[2] on, and returns the index of the argument
+// after them, which should be the path.
+static int parseOptions(int argc, char* argv[], ParseOptions& options)
 {
-  if (argc == 3 && std::strcmp(argv[1], "--read") == 0) {
-    read(argv[2]);
-    return;
+  int i = 2;
+  for (; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--parallel") == 0 && !options.parallel)
+      options.parallel = true;
+    else if (std::strcmp(argv[i], "--flat") == 0 && !options.flat)
+      options.flat = true;
+    else
+      break;
   }
-  if (argc == 3 && std::strcmp(argv[1], "--lex") == 0) {
-    lex(argv[2]);
+  return i;
+}
+
+
+static void main_with_exceptions(int argc, char* argv[])
+{
+  if (argc >= 3 && std::strcmp(argv[1], "--read") == 0) {
+    bool print_statistics = std::strcmp(argv[2], "--stats") == 0;
+    if (argc == 3 && print_statistics)
+      throw std::runtime_error("bad command line arguments");
+    read({argv + 2 + print_statistics, argv + argc}, print_statistics);
     return;
   }
-  if (argc == 3 && std::strcmp(argv[1], "--parse") == 0) {
-    parse(argv[2]);
+  if (argc >= 3 && std::strcmp(argv[1], "--lex") == 0) {
+    bool parallel = std::strcmp(argv[2], "--parallel") == 0;
+    if (argc == 3 && parallel)
+      throw std::runtime_error("bad command line arguments");
+    lex({argv + 2 + parallel, argv + argc}, parallel);
     return;
   }
-  if (argc == 3 && std::strcmp(argv[1], "--compile") == 0) {
-    compile(argv[2]);
+  bool print_tree = argc >= 3 && std::strcmp(argv[1], "--parse") == 0;
+  if (argc >= 3 && (print_tree || std::strcmp(argv[1], "--compile") == 0)) {
+    ParseOptions options;
+    auto path = parseOptions(argc, argv, options);
+    if (path + 1 != argc)
+      throw std::runtime_error("bad command line arguments");
+    if (print_tree)
+      parse(argv[path], options);
+    else
+      compile(argv[path], options);
     return;
   }
   throw std::runtime_error("bad command line arguments");
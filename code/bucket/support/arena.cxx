@@ -0,0 +1,29 @@
+#include "common.hxx"
+#include "support/arena.hxx"
+#include <algorithm>
+#include <utility>
+
+namespace support {
+
+Arena::Arena() noexcept
+: mBlockCursor(0),
+  mBlockEnd(0),
+  mCapacity(0)
+{}
+
+void Arena::grow(std::size_t size)
+{
+  // each block is as large as all of the ones before it, up to a limit, so
+  // that a large arena is made of few blocks
+  auto block_size = mBlocks.empty() ? FIRST_BLOCK_SIZE : std::min(mCapacity, MAX_BLOCK_SIZE);
+  block_size = std::max(block_size, size);
+  auto units = (block_size + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+  // left uninitialized, unlike with std::make_unique<T[]>
+  std::unique_ptr<std::max_align_t[]> block{new std::max_align_t[units]};
+  mBlocks.push_back(std::move(block));
+  mBlockCursor = reinterpret_cast<std::uintptr_t>(mBlocks.back().get());
+  mBlockEnd = mBlockCursor + units * sizeof(std::max_align_t);
+  mCapacity += units * sizeof(std::max_align_t);
+}
+
+}
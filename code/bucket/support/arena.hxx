@@ -0,0 +1,102 @@
+// arena.hxx
+// Defines the class Arena, a bump allocator. Objects are placed one after
+// another in large blocks and are never freed on their own; the blocks are
+// released together when the arena is destroyed, without running any
+// destructors, so only trivially destructible types may be created in it. An
+// arena is not safe to use from several threads at once.
+
+#ifndef BUCKET_SUPPORT_ARENA_HXX
+#define BUCKET_SUPPORT_ARENA_HXX
+
+#include "common.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace support {
+
+class Arena {
+
+public:
+
+  Arena() noexcept;
+
+  Arena(const Arena&) = delete;
+
+  Arena& operator=(const Arena&) = delete;
+
+  // Returns 'size' bytes aligned to 'alignment', which must be a power of two
+  // no greater than alignof(std::max_align_t).
+  void* allocate(std::size_t size, std::size_t alignment);
+
+  template <typename T, typename... Args>
+  T* create(Args&&... args);
+
+  // Returns a copy of the 'count' objects at 'first'.
+  template <typename T>
+  T* copy(const T* first, std::size_t count);
+
+  // The number of bytes taken from the system, including what is not yet
+  // handed out.
+  std::size_t capacity() const noexcept;
+
+private:
+
+  static constexpr std::size_t FIRST_BLOCK_SIZE = 64 * 1024;
+
+  static constexpr std::size_t MAX_BLOCK_SIZE = 4 * 1024 * 1024;
+
+  std::vector<std::unique_ptr<std::max_align_t[]>> mBlocks;
+
+  std::uintptr_t mBlockCursor;
+
+  std::uintptr_t mBlockEnd;
+
+  std::size_t mCapacity;
+
+  // Starts a block that has room for at least 'size' bytes.
+  void grow(std::size_t size);
+
+};
+
+inline void* Arena::allocate(std::size_t size, std::size_t alignment)
+{
+  auto start = (mBlockCursor + alignment - 1) & ~(alignment - 1);
+  if (start + size > mBlockEnd) {
+    grow(size);
+    start = mBlockCursor;
+  }
+  mBlockCursor = start + size;
+  return reinterpret_cast<void*>(start);
+}
+
+template <typename T, typename... Args>
+T* Arena::create(Args&&... args)
+{
+  static_assert(std::is_trivially_destructible<T>::value, "the arena never destroys what it holds");
+  return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+}
+
+template <typename T>
+T* Arena::copy(const T* first, std::size_t count)
+{
+  static_assert(std::is_trivially_destructible<T>::value, "the arena never destroys what it holds");
+  if (count == 0)
+    return nullptr;
+  auto copied = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+  std::uninitialized_copy(first, first + count, copied);
+  return copied;
+}
+
+inline std::size_t Arena::capacity() const noexcept
+{
+  return mCapacity;
+}
+
+}
+
+#endif
@@ -0,0 +1,97 @@
+#include "common.hxx"
+#include "support/bytescan.hxx"
+#include <cstdint>
+
+#ifdef BUCKET_HAVE_X86_SIMD
+  #include <immintrin.h>
+#endif
+
+namespace support {
+
+namespace {
+
+constexpr bool isBlank(unsigned char byte) noexcept
+{
+  return byte == ' ' || byte == '\t' || byte == '\v' || byte == '\f';
+}
+
+const unsigned char* findEitherByteScalar(const unsigned char* first, const unsigned char* last, unsigned char a, unsigned char b) noexcept
+{
+  while (first != last && *first != a && *first != b)
+    ++first;
+  return first;
+}
+
+const unsigned char* skipBlanksScalar(const unsigned char* first, const unsigned char* last) noexcept
+{
+  while (first != last && isBlank(*first))
+    ++first;
+  return first;
+}
+
+#ifdef BUCKET_HAVE_X86_SIMD
+
+__attribute__((target("sse2")))
+const unsigned char* findEitherByteSSE2(const unsigned char* first, const unsigned char* last, unsigned char a, unsigned char b) noexcept
+{
+  const auto a_bytes = _mm_set1_epi8(static_cast<char>(a));
+  const auto b_bytes = _mm_set1_epi8(static_cast<char>(b));
+  for (; last - first >= 16; first += 16) {
+    auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    auto matches = _mm_or_si128(_mm_cmpeq_epi8(block, a_bytes), _mm_cmpeq_epi8(block, b_bytes));
+    auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(matches));
+    if (mask)
+      return first + __builtin_ctz(mask);
+  }
+  return findEitherByteScalar(first, last, a, b);
+}
+
+__attribute__((target("sse2")))
+const unsigned char* skipBlanksSSE2(const unsigned char* first, const unsigned char* last) noexcept
+{
+  const auto spaces = _mm_set1_epi8(' ');
+  const auto tabs = _mm_set1_epi8('\t');
+  const auto vertical_tabs = _mm_set1_epi8('\v');
+  const auto form_feeds = _mm_set1_epi8('\f');
+  for (; last - first >= 16; first += 16) {
+    auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    auto blanks = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(block, spaces), _mm_cmpeq_epi8(block, tabs)),
+      _mm_or_si128(_mm_cmpeq_epi8(block, vertical_tabs), _mm_cmpeq_epi8(block, form_feeds))
+    );
+    auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(blanks)) ^ 0xFFFF;
+    if (mask)
+      return first + __builtin_ctz(mask);
+  }
+  return skipBlanksScalar(first, last);
+}
+
+bool hasSSE2() noexcept
+{
+  static const bool has_sse2 = __builtin_cpu_supports("sse2");
+  return has_sse2;
+}
+
+#endif
+
+}
+
+const unsigned char* findEitherByte(const unsigned char* first, const unsigned char* last, unsigned char a, unsigned char b) noexcept
+{
+  #ifdef BUCKET_HAVE_X86_SIMD
+  if (hasSSE2())
+    return findEitherByteSSE2(first, last, a, b);
+  #endif
+  return findEitherByteScalar(first, last, a, b);
+}
+
+const unsigned char* skipBlanks(const unsigned char* first, const unsigned char* last) noexcept
+{
+  #ifdef BUCKET_HAVE_X86_SIMD
+  if (hasSSE2())
+    return skipBlanksSSE2(first, last);
+  #endif
+  return skipBlanksScalar(first, last);
+}
+
+}
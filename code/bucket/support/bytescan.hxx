@@ -0,0 +1,24 @@
+// bytescan.hxx
+// Functions that scan a buffer for the bytes that end a comment or a run of
+// blanks, sixteen bytes at a time with SSE2 where the CPU supports it. The
+// lexer uses them to step over comments and indentation without looking at
+// every byte on its own.
+
+#ifndef BUCKET_SUPPORT_BYTESCAN_HXX
+#define BUCKET_SUPPORT_BYTESCAN_HXX
+
+#include "common.hxx"
+
+namespace support {
+
+// Returns the first byte in [first, last) that equals 'a' or 'b', or 'last'
+// if there is none.
+const unsigned char* findEitherByte(const unsigned char* first, const unsigned char* last, unsigned char a, unsigned char b) noexcept;
+
+// Returns the first byte in [first, last) that is not a blank (' ', '\t',
+// '\v' or '\f'), or 'last' if there is none.
+const unsigned char* skipBlanks(const unsigned char* first, const unsigned char* last) noexcept;
+
+}
+
+#endif
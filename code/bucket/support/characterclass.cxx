@@ -0,0 +1,71 @@
+#include "common.hxx"
+#include "support/characterclass.hxx"
+#include "support/unicodetables.hxx"
+#include <cstddef>
+
+#ifdef BUCKET_DEBUG_BUILD
+  #include <algorithm>
+  #include <cassert>
+  #include <iterator>
+#endif
+
+namespace support {
+
+namespace {
+
+constexpr std::array<unsigned char, 128> buildAsciiCharacterClasses() noexcept
+{
+  std::array<unsigned char, 128> classes{};
+  for (unsigned char c = 'a'; c <= 'z'; ++c)
+    classes[c] = Letter | IdentifierStart | IdentifierContinue;
+  for (unsigned char c = 'A'; c <= 'Z'; ++c)
+    classes[c] = Letter | IdentifierStart | IdentifierContinue;
+  for (unsigned char c = '0'; c <= '9'; ++c)
+    classes[c] = NumericDigit | IdentifierContinue;
+  classes['_'] = IdentifierStart | IdentifierContinue;
+  return classes;
+}
+
+constexpr std::int32_t CODE_SPACE_SIZE = 0x110000;
+
+constexpr std::int32_t BLOCK_SIZE = 256;
+
+static_assert(std::size(unicode_tables::blockIndex) == CODE_SPACE_SIZE / BLOCK_SIZE);
+
+#ifdef BUCKET_DEBUG_BUILD
+
+template <std::size_t N>
+bool isInRanges(const unicode_tables::CodePointRange (&ranges)[N], std::int32_t code_point) noexcept
+{
+  auto iter = std::upper_bound(std::begin(ranges), std::end(ranges), code_point, [](std::int32_t value, const unicode_tables::CodePointRange& range) {
+    return value < range.first;
+  });
+  return iter != std::begin(ranges) && code_point <= std::prev(iter)->last;
+}
+
+#endif
+
+}
+
+const std::array<unsigned char, 128> asciiCharacterClasses = buildAsciiCharacterClasses();
+
+unsigned char nonAsciiCharacterClasses(std::int32_t code_point) noexcept
+{
+  if (code_point < 0 || code_point >= CODE_SPACE_SIZE)
+    return 0;
+  auto& block = unicode_tables::bitmapBlocks[unicode_tables::blockIndex[code_point / BLOCK_SIZE]];
+  auto word = (code_point % BLOCK_SIZE) / 64;
+  auto bit = std::uint64_t{1} << (code_point % 64);
+  unsigned char classes = 0;
+  if (block.letter[word] & bit)
+    classes = Letter | IdentifierStart | IdentifierContinue;
+  else if (block.numeric_digit[word] & bit)
+    classes = NumericDigit | IdentifierContinue;
+  #ifdef BUCKET_DEBUG_BUILD
+  assert(static_cast<bool>(classes & Letter) == isInRanges(unicode_tables::letterRanges, code_point));
+  assert(static_cast<bool>(classes & NumericDigit) == isInRanges(unicode_tables::numericDigitRanges, code_point));
+  #endif
+  return classes;
+}
+
+}
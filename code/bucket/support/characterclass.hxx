@@ -0,0 +1,41 @@
+// characterclass.hxx
+// Classifies code points for the lexer. ASCII code points are looked up in a
+// 128-entry table. Everything else goes through a two-level bitmap: the code
+// point's 256-entry block selects one of a small set of distinct bitmap
+// blocks, which hold one bit per code point for each class. The bitmap is
+// generated at build time (see support/unicodetables.hxx), so classification
+// needs neither utf8proc nor any work at startup.
+
+#ifndef BUCKET_SUPPORT_CHARACTERCLASS_HXX
+#define BUCKET_SUPPORT_CHARACTERCLASS_HXX
+
+#include "common.hxx"
+#include <array>
+#include <cstdint>
+
+namespace support {
+
+enum CharacterClass : unsigned char {
+  Letter             = 1 << 0, // general category L*
+  NumericDigit       = 1 << 1, // general category Nd
+  IdentifierStart    = 1 << 2, // a letter or '_'
+  IdentifierContinue = 1 << 3  // a letter, a numeric digit, or '_'
+};
+
+extern const std::array<unsigned char, 128> asciiCharacterClasses;
+
+unsigned char nonAsciiCharacterClasses(std::int32_t code_point) noexcept;
+
+// Returns the classes of the code point as a set of CharacterClass bits. Any
+// value outside of the Unicode code space (such as -1 for end of file) belongs
+// to no class.
+inline unsigned char characterClasses(std::int32_t code_point) noexcept
+{
+  if (static_cast<std::uint32_t>(code_point) < 128)
+    return asciiCharacterClasses[static_cast<std::uint32_t>(code_point)];
+  return nonAsciiCharacterClasses(code_point);
+}
+
+}
+
+#endif
@@ -0,0 +1,654 @@
+#include "common.hxx"
+#include "support/fileloader.hxx"
+#include "support/concatenate.hxx"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#ifdef BUCKET_HAVE_POSIX
+  #include <cerrno>
+  #include <fcntl.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#else
+  #include <fstream>
+  #include <iterator>
+#endif
+
+#ifdef BUCKET_HAVE_IO_URING
+  #include <linux/io_uring.h>
+  #include <sys/mman.h>
+  #include <sys/syscall.h>
+#endif
+
+namespace support {
+
+namespace {
+
+std::runtime_error openError(const std::string& path)
+{
+  return std::runtime_error(concatenate("unable to open file '", path.c_str(), '\''));
+}
+
+std::runtime_error readError(const std::string& path)
+{
+  return std::runtime_error(concatenate("failed to read from file '", path.c_str(), '\''));
+}
+
+#ifdef BUCKET_HAVE_POSIX
+
+// Reads from the current position of the descriptor until end of file,
+// appending to a buffer that holds 'size' bytes and has room for 'capacity'.
+void readToEnd(int file_descriptor, const std::string& path, std::unique_ptr<unsigned char[]>& buffer, std::size_t& size, std::size_t& capacity)
+{
+  while (true) {
+    if (size == capacity) {
+      auto larger_buffer = std::make_unique<unsigned char[]>(capacity * 2);
+      std::memcpy(larger_buffer.get(), buffer.get(), size);
+      buffer = std::move(larger_buffer);
+      capacity *= 2;
+    }
+    auto bytes_read = ::read(file_descriptor, buffer.get() + size, capacity - size);
+    if (bytes_read == -1) {
+      if (errno == EINTR)
+        continue;
+      throw readError(path);
+    }
+    if (bytes_read == 0)
+      return;
+    size += static_cast<std::size_t>(bytes_read);
+  }
+}
+
+FileLoader::LoadedFile readFile(std::size_t index, const std::string& path)
+{
+  int file_descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file_descriptor == -1)
+    throw openError(path);
+
+  FileLoader::LoadedFile file{index, nullptr, 0};
+  try {
+    struct stat status;
+    if (::fstat(file_descriptor, &status) == -1)
+      throw openError(path);
+
+    // regular files that report a size of zero, such as those under /proc,
+    // may still have contents, and are read like pipes
+    if (S_ISREG(status.st_mode) && status.st_size != 0) {
+      // the size is known, so the whole file is read with as few calls as
+      // possible; a file that shrinks while it is read is cut short
+      auto size = static_cast<std::size_t>(status.st_size);
+      file.contents = std::make_unique<unsigned char[]>(size);
+      while (file.size != size) {
+        auto bytes_read = ::pread(file_descriptor, file.contents.get() + file.size, size - file.size, static_cast<off_t>(file.size));
+        if (bytes_read == -1) {
+          if (errno == EINTR)
+            continue;
+          throw readError(path);
+        }
+        if (bytes_read == 0)
+          break;
+        file.size += static_cast<std::size_t>(bytes_read);
+      }
+    }
+    else {
+      std::size_t capacity = 1 << 16;
+      file.contents = std::make_unique<unsigned char[]>(capacity);
+      readToEnd(file_descriptor, path, file.contents, file.size, capacity);
+    }
+  } catch (...) {
+    ::close(file_descriptor);
+    throw;
+  }
+  ::close(file_descriptor);
+  return file;
+}
+
+#else
+
+FileLoader::LoadedFile readFile(std::size_t index, const std::string& path)
+{
+  std::ifstream stream{path, std::ios::binary};
+  if (!stream)
+    throw openError(path);
+  std::vector<char> contents{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+  if (stream.bad())
+    throw readError(path);
+  FileLoader::LoadedFile file{index, std::make_unique<unsigned char[]>(contents.size()), contents.size()};
+  std::memcpy(file.contents.get(), contents.data(), contents.size());
+  return file;
+}
+
+#endif
+
+#ifdef BUCKET_HAVE_IO_URING
+
+constexpr unsigned IO_URING_ENTRIES = 128;
+
+int ioUringSetup(unsigned entries, io_uring_params* params) noexcept
+{
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ioUringEnter(int ring, unsigned to_submit, unsigned min_complete, unsigned flags) noexcept
+{
+  return static_cast<int>(::syscall(__NR_io_uring_enter, ring, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int ioUringRegister(int ring, unsigned opcode, void* arg, unsigned nr_args) noexcept
+{
+  return static_cast<int>(::syscall(__NR_io_uring_register, ring, opcode, arg, nr_args));
+}
+
+// Checks that io_uring can be set up and supports every operation the loader
+// submits (openat, statx and close need Linux 5.6).
+bool ioUringIsUsable() noexcept
+{
+  io_uring_params params{};
+  int ring = ioUringSetup(IO_URING_ENTRIES, &params);
+  if (ring < 0)
+    return false;
+  bool usable = false;
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    constexpr unsigned PROBED_OPS = 256;
+    auto probe_storage = std::make_unique<unsigned char[]>(sizeof(io_uring_probe) + PROBED_OPS * sizeof(io_uring_probe_op));
+    auto probe = reinterpret_cast<io_uring_probe*>(probe_storage.get());
+    std::memset(probe, 0, sizeof(io_uring_probe) + PROBED_OPS * sizeof(io_uring_probe_op));
+    if (ioUringRegister(ring, IORING_REGISTER_PROBE, probe, PROBED_OPS) == 0) {
+      usable = true;
+      for (unsigned op : {IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_CLOSE})
+        if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED))
+          usable = false;
+    }
+  }
+  ::close(ring);
+  return usable;
+}
+
+#endif
+
+}
+
+// ThreadPool:
+// Each worker takes the next path from the list, reads the whole file with
+// pread(), and queues the result for next().
+
+class FileLoader::ThreadPool {
+
+public:
+
+  explicit ThreadPool(const std::vector<std::string>& paths);
+
+  ~ThreadPool();
+
+  LoadedFile wait();
+
+private:
+
+  struct Result {
+    LoadedFile file;
+    std::exception_ptr error;
+  };
+
+  const std::vector<std::string>& mPaths;
+
+  std::atomic<std::size_t> mNextPath;
+
+  std::mutex mMutex;
+
+  std::condition_variable mCompleted;
+
+  std::deque<Result> mResults;
+
+  std::vector<std::thread> mThreads;
+
+  void work();
+
+};
+
+FileLoader::ThreadPool::ThreadPool(const std::vector<std::string>& paths)
+: mPaths{paths},
+  mNextPath{0}
+{
+  // the threads mostly wait for the disk, so there are more of them than
+  // there are cores
+  auto thread_count = std::min<std::size_t>(paths.size(), std::max(16u, 2 * std::thread::hardware_concurrency()));
+  mThreads.reserve(thread_count);
+  for (std::size_t i = 0; i != thread_count; ++i)
+    mThreads.emplace_back(&ThreadPool::work, this);
+}
+
+FileLoader::ThreadPool::~ThreadPool()
+{
+  // let the workers finish the files they have started and nothing more
+  mNextPath = mPaths.size();
+  for (auto& thread : mThreads)
+    thread.join();
+}
+
+FileLoader::LoadedFile FileLoader::ThreadPool::wait()
+{
+  std::unique_lock<std::mutex> lock{mMutex};
+  mCompleted.wait(lock, [this] { return !mResults.empty(); });
+  auto result = std::move(mResults.front());
+  mResults.pop_front();
+  lock.unlock();
+  if (result.error)
+    std::rethrow_exception(result.error);
+  return std::move(result.file);
+}
+
+void FileLoader::ThreadPool::work()
+{
+  while (true) {
+    auto index = mNextPath++;
+    if (index >= mPaths.size())
+      return;
+    Result result{{index, nullptr, 0}, nullptr};
+    try {
+      result.file = readFile(index, mPaths[index]);
+    } catch (...) {
+      result.error = std::current_exception();
+    }
+    {
+      std::lock_guard<std::mutex> lock{mMutex};
+      mResults.push_back(std::move(result));
+    }
+    mCompleted.notify_one();
+  }
+}
+
+#ifdef BUCKET_HAVE_IO_URING
+
+// IoUring:
+// Runs on the thread that calls next(); there are no helper threads. Each file
+// goes through the following steps, each step being one or two requests on
+// the ring:
+//   1. openat and statx, submitted together
+//   2. read, resubmitted until the whole file has been read
+//   3. close
+// Up to MAX_FILES_IN_FLIGHT files are worked on at once.
+
+class FileLoader::IoUring {
+
+public:
+
+  explicit IoUring(const std::vector<std::string>& paths);
+
+  ~IoUring();
+
+  LoadedFile wait();
+
+private:
+
+  static constexpr std::size_t MAX_FILES_IN_FLIGHT = IO_URING_ENTRIES / 2;
+
+  // the low bits of each request's user data say which step it belongs to
+  enum Step : std::uint64_t {
+    Open, Stat, Read, Close
+  };
+
+  struct Request {
+    int file_descriptor = -1;
+    unsigned pending = 0;
+    int error = 0;
+    bool failed_to_open = false;
+    struct statx status;
+    LoadedFile file;
+  };
+
+  const std::vector<std::string>& mPaths;
+
+  std::vector<Request> mRequests;
+
+  std::size_t mNextPath;
+
+  std::size_t mFilesInFlight;
+
+  std::deque<std::size_t> mCompleted;
+
+  int mRing;
+
+  void* mRingMemory;
+
+  std::size_t mRingMemorySize;
+
+  io_uring_sqe* mSubmissionEntries;
+
+  std::size_t mSubmissionEntriesSize;
+
+  unsigned* mSubmissionHead;
+  unsigned* mSubmissionTail;
+  unsigned mSubmissionMask;
+  unsigned* mSubmissionArray;
+
+  unsigned* mCompletionHead;
+  unsigned* mCompletionTail;
+  unsigned mCompletionMask;
+  io_uring_cqe* mCompletionEntries;
+
+  // requests added to the submission queue but not yet passed to the kernel
+  unsigned mUnsubmitted;
+
+  // requests passed to the kernel whose completions have not been seen
+  std::size_t mOutstanding;
+
+  io_uring_sqe* addRequest(std::size_t index, Step step);
+
+  void submitAndWait(unsigned min_complete);
+
+  void start(std::size_t index);
+
+  void read(std::size_t index);
+
+  void finish(std::size_t index);
+
+  void complete(std::uint64_t user_data, int result);
+
+};
+
+FileLoader::IoUring::IoUring(const std::vector<std::string>& paths)
+: mPaths{paths},
+  mRequests(paths.size()),
+  mNextPath{0},
+  mFilesInFlight{0},
+  mUnsubmitted{0},
+  mOutstanding{0}
+{
+  io_uring_params params{};
+  mRing = ioUringSetup(IO_URING_ENTRIES, &params);
+  if (mRing < 0)
+    throw std::runtime_error("unable to set up io_uring");
+
+  // with IORING_FEAT_SINGLE_MMAP, one mapping holds both rings
+  mRingMemorySize = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned), params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+  mRingMemory = ::mmap(nullptr, mRingMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRing, IORING_OFF_SQ_RING);
+  if (mRingMemory == MAP_FAILED) {
+    ::close(mRing);
+    throw std::runtime_error("unable to set up io_uring");
+  }
+  mSubmissionEntriesSize = params.sq_entries * sizeof(io_uring_sqe);
+  void* entries = ::mmap(nullptr, mSubmissionEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRing, IORING_OFF_SQES);
+  if (entries == MAP_FAILED) {
+    ::munmap(mRingMemory, mRingMemorySize);
+    ::close(mRing);
+    throw std::runtime_error("unable to set up io_uring");
+  }
+  mSubmissionEntries = static_cast<io_uring_sqe*>(entries);
+
+  auto ring = static_cast<unsigned char*>(mRingMemory);
+  mSubmissionHead = reinterpret_cast<unsigned*>(ring + params.sq_off.head);
+  mSubmissionTail = reinterpret_cast<unsigned*>(ring + params.sq_off.tail);
+  mSubmissionMask = *reinterpret_cast<unsigned*>(ring + params.sq_off.ring_mask);
+  mSubmissionArray = reinterpret_cast<unsigned*>(ring + params.sq_off.array);
+  mCompletionHead = reinterpret_cast<unsigned*>(ring + params.cq_off.head);
+  mCompletionTail = reinterpret_cast<unsigned*>(ring + params.cq_off.tail);
+  mCompletionMask = *reinterpret_cast<unsigned*>(ring + params.cq_off.ring_mask);
+  mCompletionEntries = reinterpret_cast<io_uring_cqe*>(ring + params.cq_off.cqes);
+}
+
+FileLoader::IoUring::~IoUring()
+{
+  // the kernel may still be writing into buffers owned by the requests, so
+  // every outstanding request is waited for; files that were opened are
+  // closed
+  try {
+    mNextPath = mPaths.size();
+    while (mOutstanding != 0 || mUnsubmitted != 0)
+      submitAndWait(1);
+  } catch (...) {
+  }
+  for (auto& request : mRequests)
+    if (request.file_descriptor != -1)
+      ::close(request.file_descriptor);
+  ::munmap(mSubmissionEntries, mSubmissionEntriesSize);
+  ::munmap(mRingMemory, mRingMemorySize);
+  ::close(mRing);
+}
+
+FileLoader::LoadedFile FileLoader::IoUring::wait()
+{
+  while (mCompleted.empty()) {
+    while (mFilesInFlight != MAX_FILES_IN_FLIGHT && mNextPath != mPaths.size())
+      start(mNextPath++);
+    submitAndWait(1);
+  }
+  auto index = mCompleted.front();
+  mCompleted.pop_front();
+  auto& request = mRequests[index];
+  if (request.failed_to_open)
+    throw openError(mPaths[index]);
+  if (request.error != 0)
+    throw readError(mPaths[index]);
+  return std::move(request.file);
+}
+
+io_uring_sqe* FileLoader::IoUring::addRequest(std::size_t index, Step step)
+{
+  auto tail = *mSubmissionTail;
+  if (tail - __atomic_load_n(mSubmissionHead, __ATOMIC_ACQUIRE) == mSubmissionMask + 1) {
+    submitAndWait(0);
+    tail = *mSubmissionTail;
+  }
+  auto slot = tail & mSubmissionMask;
+  auto entry = &mSubmissionEntries[slot];
+  std::memset(entry, 0, sizeof(io_uring_sqe));
+  entry->user_data = (static_cast<std::uint64_t>(index) << 2) | step;
+  mSubmissionArray[slot] = slot;
+  __atomic_store_n(mSubmissionTail, tail + 1, __ATOMIC_RELEASE);
+  ++mUnsubmitted;
+  return entry;
+}
+
+void FileLoader::IoUring::submitAndWait(unsigned min_complete)
+{
+  while (true) {
+    auto submitted = ioUringEnter(mRing, mUnsubmitted, min_complete, min_complete ? IORING_ENTER_GETEVENTS : 0);
+    if (submitted >= 0) {
+      mUnsubmitted -= static_cast<unsigned>(submitted);
+      mOutstanding += static_cast<std::size_t>(submitted);
+      break;
+    }
+    // when the kernel is out of resources, reaping completions frees some
+    if (errno == EAGAIN || errno == EBUSY)
+      break;
+    if (errno != EINTR)
+      throw std::runtime_error("io_uring_enter failed");
+  }
+
+  auto head = *mCompletionHead;
+  auto tail = __atomic_load_n(mCompletionTail, __ATOMIC_ACQUIRE);
+  for (; head != tail; ++head) {
+    auto& entry = mCompletionEntries[head & mCompletionMask];
+    auto user_data = entry.user_data;
+    auto result = entry.res;
+    __atomic_store_n(mCompletionHead, head + 1, __ATOMIC_RELEASE);
+    --mOutstanding;
+    complete(user_data, result);
+  }
+}
+
+void FileLoader::IoUring::start(std::size_t index)
+{
+  ++mFilesInFlight;
+  auto& request = mRequests[index];
+  request.file.index = index;
+  request.pending = 2;
+
+  auto open = addRequest(index, Open);
+  open->opcode = IORING_OP_OPENAT;
+  open->fd = AT_FDCWD;
+  open->addr = reinterpret_cast<std::uint64_t>(mPaths[index].c_str());
+  open->open_flags = O_RDONLY | O_CLOEXEC;
+
+  auto stat = addRequest(index, Stat);
+  stat->opcode = IORING_OP_STATX;
+  stat->fd = AT_FDCWD;
+  stat->addr = reinterpret_cast<std::uint64_t>(mPaths[index].c_str());
+  stat->len = STATX_TYPE | STATX_SIZE;
+  stat->off = reinterpret_cast<std::uint64_t>(&request.status);
+}
+
+void FileLoader::IoUring::read(std::size_t index)
+{
+  auto& request = mRequests[index];
+  auto entry = addRequest(index, Read);
+  entry->opcode = IORING_OP_READ;
+  entry->fd = request.file_descriptor;
+  entry->addr = reinterpret_cast<std::uint64_t>(request.file.contents.get() + request.file.size);
+  entry->len = static_cast<std::uint32_t>(std::min<std::size_t>(request.status.stx_size - request.file.size, 1 << 30));
+  entry->off = request.file.size;
+}
+
+void FileLoader::IoUring::finish(std::size_t index)
+{
+  auto& request = mRequests[index];
+  if (request.file_descriptor == -1) {
+    --mFilesInFlight;
+    mCompleted.push_back(index);
+    return;
+  }
+  auto entry = addRequest(index, Close);
+  entry->opcode = IORING_OP_CLOSE;
+  entry->fd = request.file_descriptor;
+}
+
+void FileLoader::IoUring::complete(std::uint64_t user_data, int result)
+{
+  auto index = static_cast<std::size_t>(user_data >> 2);
+  auto& request = mRequests[index];
+  switch (static_cast<Step>(user_data & 3)) {
+
+    case Open:
+    case Stat:
+      if (result < 0)
+        request.failed_to_open = true;
+      else if ((user_data & 3) == Open)
+        request.file_descriptor = result;
+      if (--request.pending != 0)
+        return;
+      if (request.failed_to_open) {
+        finish(index);
+      }
+      else if (!S_ISREG(request.status.stx_mode) || request.status.stx_size == 0) {
+        // files of unknown size (pipes, devices, and regular files reporting
+        // a size of zero, such as those under /proc) are rare enough to be
+        // read with plain blocking reads
+        std::size_t capacity = 1 << 16;
+        request.file.contents = std::make_unique<unsigned char[]>(capacity);
+        try {
+          readToEnd(request.file_descriptor, mPaths[index], request.file.contents, request.file.size, capacity);
+        } catch (...) {
+          request.error = EIO;
+        }
+        finish(index);
+      }
+      else {
+        request.file.contents = std::make_unique<unsigned char[]>(request.status.stx_size);
+        read(index);
+      }
+      return;
+
+    case Read:
+      if (result == -EINTR || result == -EAGAIN) {
+        read(index);
+      }
+      else if (result < 0) {
+        request.error = -result;
+        finish(index);
+      }
+      else {
+        // a file that shrinks while it is read is cut short
+        request.file.size += static_cast<std::size_t>(result);
+        if (result == 0 || request.file.size == request.status.stx_size)
+          finish(index);
+        else
+          read(index);
+      }
+      return;
+
+    case Close:
+      request.file_descriptor = -1;
+      --mFilesInFlight;
+      mCompleted.push_back(index);
+      return;
+
+  }
+}
+
+#endif
+
+std::string_view fileLoaderMethodToString(FileLoaderMethod method) noexcept
+{
+  switch (method) {
+    case FileLoaderMethod::ThreadPool: return "thread-pool";
+    case FileLoaderMethod::IoUring:    return "io_uring";
+  }
+  return "";
+}
+
+bool isFileLoaderMethodSupported(FileLoaderMethod method) noexcept
+{
+  switch (method) {
+    case FileLoaderMethod::ThreadPool:
+      return true;
+    case FileLoaderMethod::IoUring:
+      #ifdef BUCKET_HAVE_IO_URING
+      {
+        static const bool usable = ioUringIsUsable();
+        return usable;
+      }
+      #else
+      return false;
+      #endif
+  }
+  return false;
+}
+
+FileLoader::FileLoader(std::vector<std::string> paths)
+: FileLoader(std::move(paths), isFileLoaderMethodSupported(FileLoaderMethod::IoUring) ? FileLoaderMethod::IoUring : FileLoaderMethod::ThreadPool)
+{}
+
+FileLoader::FileLoader(std::vector<std::string> paths, FileLoaderMethod method)
+: mPaths{std::move(paths)},
+  mMethod{method},
+  mFilesReturned{0}
+{
+  if (!isFileLoaderMethodSupported(method))
+    throw std::runtime_error(concatenate("file loading method '", fileLoaderMethodToString(method), "' is not supported"));
+  #ifdef BUCKET_HAVE_IO_URING
+  if (method == FileLoaderMethod::IoUring) {
+    mIoUring = std::make_unique<IoUring>(mPaths);
+    return;
+  }
+  #endif
+  mThreadPool = std::make_unique<ThreadPool>(mPaths);
+}
+
+FileLoader::~FileLoader() = default;
+
+std::optional<FileLoader::LoadedFile> FileLoader::next()
+{
+  if (mFilesReturned == mPaths.size())
+    return std::nullopt;
+  ++mFilesReturned;
+  #ifdef BUCKET_HAVE_IO_URING
+  if (mIoUring)
+    return mIoUring->wait();
+  #endif
+  return mThreadPool->wait();
+}
+
+FileLoaderMethod FileLoader::method() const noexcept
+{
+  return mMethod;
+}
+
+}
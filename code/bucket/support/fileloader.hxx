@@ -0,0 +1,84 @@
+// fileloader.hxx
+// Defines the class FileLoader, which reads a list of files into memory with
+// many reads in flight at once, so that loading a large project is not
+// serialized behind one file at a time. On Linux, opens and reads are
+// submitted in batches through io_uring; elsewhere, or when the kernel does
+// not support it, a pool of threads reads the files with pread(). Files are
+// handed out in the order their reads complete, so that each can be lexed
+// while the rest are still being read.
+
+#ifndef BUCKET_SUPPORT_FILELOADER_HXX
+#define BUCKET_SUPPORT_FILELOADER_HXX
+
+#include "common.hxx"
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace support {
+
+enum class FileLoaderMethod {
+  ThreadPool, IoUring
+};
+
+std::string_view fileLoaderMethodToString(FileLoaderMethod method) noexcept;
+
+bool isFileLoaderMethodSupported(FileLoaderMethod method) noexcept;
+
+class FileLoader {
+
+public:
+
+  struct LoadedFile {
+    // the position of the file's path in the list given to the loader
+    std::size_t index;
+    std::unique_ptr<unsigned char[]> contents;
+    std::size_t size;
+  };
+
+  // Starts loading the files at 'paths', using io_uring if the kernel
+  // supports it.
+  explicit FileLoader(std::vector<std::string> paths);
+
+  FileLoader(std::vector<std::string> paths, FileLoaderMethod method);
+
+  FileLoader(const FileLoader&) = delete;
+
+  FileLoader& operator=(const FileLoader&) = delete;
+
+  // Stops loading; reads that are already in flight are waited for.
+  ~FileLoader();
+
+  // Waits until another file has been read and returns it. Returns nothing
+  // once every file has been returned. Throws if the file cannot be opened or
+  // read.
+  std::optional<LoadedFile> next();
+
+  FileLoaderMethod method() const noexcept;
+
+private:
+
+  class ThreadPool;
+
+  class IoUring;
+
+  std::vector<std::string> mPaths;
+
+  FileLoaderMethod mMethod;
+
+  std::size_t mFilesReturned;
+
+  std::unique_ptr<ThreadPool> mThreadPool;
+
+  #ifdef BUCKET_HAVE_IO_URING
+  std::unique_ptr<IoUring> mIoUring;
+  #endif
+
+};
+
+}
+
+#endif
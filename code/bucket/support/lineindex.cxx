@@ -0,0 +1,120 @@
+#include "common.hxx"
+#include "support/lineindex.hxx"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+#ifdef BUCKET_HAVE_X86_SIMD
+  #include <immintrin.h>
+#endif
+
+namespace support {
+
+namespace {
+
+std::uint32_t countCodePoints(const unsigned char* begin, const unsigned char* end) noexcept
+{
+  std::uint32_t count = 0;
+  for (; begin != end; ++begin)
+    count += (*begin & 0xC0) != 0x80;
+  return count;
+}
+
+void findNewlinesScalar(const unsigned char* data, std::size_t size, std::uint32_t offset, std::vector<std::uint32_t>& line_starts)
+{
+  auto end = data + size;
+  for (auto p = data; (p = static_cast<const unsigned char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)))); ++p)
+    line_starts.push_back(offset + static_cast<std::uint32_t>(p - data) + 1);
+}
+
+#ifdef BUCKET_HAVE_X86_SIMD
+
+__attribute__((target("avx2")))
+void findNewlinesAVX2(const unsigned char* data, std::size_t size, std::uint32_t offset, std::vector<std::uint32_t>& line_starts)
+{
+  const auto newline = _mm256_set1_epi8('\n');
+  std::size_t i = 0;
+  for (; size - i >= 32; i += 32) {
+    auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline)));
+    while (mask) {
+      line_starts.push_back(offset + static_cast<std::uint32_t>(i) + static_cast<std::uint32_t>(__builtin_ctz(mask)) + 1);
+      mask &= mask - 1;
+    }
+  }
+  findNewlinesScalar(data + i, size - i, offset + static_cast<std::uint32_t>(i), line_starts);
+}
+
+#endif
+
+void findNewlines(const unsigned char* data, std::size_t size, std::uint32_t offset, std::vector<std::uint32_t>& line_starts)
+{
+  #ifdef BUCKET_HAVE_X86_SIMD
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  if (has_avx2) {
+    findNewlinesAVX2(data, size, offset, line_starts);
+    return;
+  }
+  #endif
+  findNewlinesScalar(data, size, offset, line_starts);
+}
+
+}
+
+void LineIndex::addChunk(const unsigned char* data, std::size_t size, std::size_t offset)
+{
+  if (offset + size > std::numeric_limits<std::uint32_t>::max())
+    throw std::runtime_error("source files larger than 4 GiB are not supported");
+  auto chunk_offset = static_cast<std::uint32_t>(offset);
+  if (mLineStarts.empty())
+    mLineStarts.push_back(chunk_offset);
+  mCheckpoints.push_back({chunk_offset, mTrailingColumns});
+
+  auto lines_before = mLineStarts.size();
+  findNewlines(data, size, chunk_offset, mLineStarts);
+
+  // keep track of the column reached at the end of the chunk
+  if (mLineStarts.size() != lines_before)
+    mTrailingColumns = countCodePoints(data + (mLineStarts.back() - chunk_offset), data + size);
+  else
+    mTrailingColumns += countCodePoints(data, data + size);
+}
+
+LineIndex::LineAndColumn LineIndex::resolve(std::size_t offset, const unsigned char* resident, std::size_t resident_offset, std::size_t resident_size) const noexcept
+{
+  if (mLineStarts.empty())
+    return {1, 1};
+
+  auto line = std::upper_bound(mLineStarts.begin(), mLineStarts.end(), offset);
+  if (line != mLineStarts.begin())
+    --line;
+  std::size_t line_start = *line;
+  auto line_number = static_cast<unsigned>(line - mLineStarts.begin()) + 1;
+
+  // count from the start of the line, or from the start of the latest chunk
+  // the line runs through, whichever comes later
+  std::size_t base = line_start;
+  std::uint32_t base_column = 0;
+  auto checkpoint = std::upper_bound(mCheckpoints.begin(), mCheckpoints.end(), offset, [](std::size_t value, const Checkpoint& c) {
+    return value < c.offset;
+  });
+  if (checkpoint != mCheckpoints.begin() && std::prev(checkpoint)->offset > line_start) {
+    base = std::prev(checkpoint)->offset;
+    base_column = std::prev(checkpoint)->column;
+  }
+  if (line_start >= resident_offset) {
+    base = line_start;
+    base_column = 0;
+  }
+
+  std::uint32_t column;
+  if (base >= resident_offset && offset <= resident_offset + resident_size)
+    column = base_column + countCodePoints(resident + (base - resident_offset), resident + (offset - resident_offset));
+  else
+    column = base_column + static_cast<std::uint32_t>(offset - base);
+  return {line_number, column + 1};
+}
+
+}
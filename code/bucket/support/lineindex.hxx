@@ -0,0 +1,57 @@
+// lineindex.hxx
+// Defines the class LineIndex, which records where each line of a file starts
+// so that byte offsets can be turned into line and column numbers only when
+// they are needed (for diagnostics, mostly). The file is fed to the index one
+// chunk at a time as it is read; newlines are found with SIMD where the CPU
+// supports it.
+
+#ifndef BUCKET_SUPPORT_LINEINDEX_HXX
+#define BUCKET_SUPPORT_LINEINDEX_HXX
+
+#include "common.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace support {
+
+class LineIndex {
+
+public:
+
+  struct LineAndColumn {
+    unsigned line, column;
+  };
+
+  // Adds the next chunk of the file, which starts at byte 'offset'. Chunks
+  // must be added in order and without gaps; the first chunk starts line one.
+  void addChunk(const unsigned char* data, std::size_t size, std::size_t offset);
+
+  // Returns the one-based line and column of the byte at 'offset'. Columns are
+  // counted in code points, using the bytes of the file that are still in
+  // memory: the 'resident_size' bytes at 'resident', which start at byte
+  // 'resident_offset' of the file. Should the start of the line no longer be
+  // in memory, the part of the line before the resident bytes is counted in
+  // bytes instead.
+  LineAndColumn resolve(std::size_t offset, const unsigned char* resident, std::size_t resident_offset, std::size_t resident_size) const noexcept;
+
+private:
+
+  // the column at the start of each chunk, used when the start of a line is
+  // no longer in memory
+  struct Checkpoint {
+    std::uint32_t offset, column;
+  };
+
+  std::vector<std::uint32_t> mLineStarts;
+
+  std::vector<Checkpoint> mCheckpoints;
+
+  // the number of code points after the last line start added so far
+  std::uint32_t mTrailingColumns = 0;
+
+};
+
+}
+
+#endif
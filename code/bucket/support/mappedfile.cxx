@@ -0,0 +1,136 @@
+#include "common.hxx"
+#include "support/mappedfile.hxx"
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#ifdef BUCKET_HAVE_POSIX
+  #include <cerrno>
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#else
+  #include <fstream>
+  #include <iterator>
+  #include <vector>
+#endif
+
+namespace support {
+
+#ifdef BUCKET_HAVE_POSIX
+
+MappedFile::MappedFile(const char* path)
+: mData{nullptr},
+  mSize{0},
+  mIsMapped{false}
+{
+  int file_descriptor = ::open(path, O_RDONLY);
+  if (file_descriptor == -1)
+    throw std::runtime_error("unable to open file");
+
+  try {
+    struct stat status;
+    if (::fstat(file_descriptor, &status) == -1)
+      throw std::runtime_error("unable to open file");
+
+    // map regular files directly; mmap() rejects zero-length mappings, so
+    // files reporting a size of zero fall through to being read
+    if (S_ISREG(status.st_mode)) {
+      mSize = static_cast<std::size_t>(status.st_size);
+      if (mSize != 0) {
+        void* address = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        if (address != MAP_FAILED) {
+          ::madvise(address, mSize, MADV_SEQUENTIAL);
+          mData = static_cast<const unsigned char*>(address);
+          mIsMapped = true;
+        }
+      }
+    }
+
+    // pipes, devices, and files that failed to map are read in full
+    if (!mIsMapped)
+      readIntoBuffer(file_descriptor);
+  } catch (...) {
+    ::close(file_descriptor);
+    throw;
+  }
+
+  // the mapping remains valid after the descriptor is closed
+  ::close(file_descriptor);
+}
+
+MappedFile::~MappedFile()
+{
+  if (mIsMapped)
+    ::munmap(const_cast<unsigned char*>(mData), mSize);
+}
+
+void MappedFile::readIntoBuffer(int file_descriptor)
+{
+  std::size_t capacity = 1 << 16;
+  std::size_t size = 0;
+  auto buffer = std::make_unique<unsigned char[]>(capacity);
+  while (true) {
+    if (size == capacity) {
+      auto larger_buffer = std::make_unique<unsigned char[]>(capacity * 2);
+      std::memcpy(larger_buffer.get(), buffer.get(), size);
+      buffer = std::move(larger_buffer);
+      capacity *= 2;
+    }
+    auto bytes_read = ::read(file_descriptor, buffer.get() + size, capacity - size);
+    if (bytes_read == -1) {
+      if (errno == EINTR)
+        continue;
+      throw std::runtime_error("failed to read from file");
+    }
+    if (bytes_read == 0)
+      break;
+    size += static_cast<std::size_t>(bytes_read);
+  }
+  mOwnedBuffer = std::move(buffer);
+  mData = mOwnedBuffer.get();
+  mSize = size;
+}
+
+#else
+
+MappedFile::MappedFile(const char* path)
+: mData{nullptr},
+  mSize{0},
+  mIsMapped{false}
+{
+  std::ifstream file{path, std::ios::binary};
+  if (!file)
+    throw std::runtime_error("unable to open file");
+  std::vector<char> contents{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  if (file.bad())
+    throw std::runtime_error("failed to read from file");
+  mSize = contents.size();
+  mOwnedBuffer = std::make_unique<unsigned char[]>(mSize);
+  std::memcpy(mOwnedBuffer.get(), contents.data(), mSize);
+  mData = mOwnedBuffer.get();
+}
+
+MappedFile::~MappedFile() = default;
+
+#endif
+
+MappedFile::MappedFile(std::unique_ptr<unsigned char[]> contents, std::size_t size) noexcept
+: mData{contents.get()},
+  mSize{size},
+  mIsMapped{false},
+  mOwnedBuffer{std::move(contents)}
+{}
+
+const unsigned char* MappedFile::data() const noexcept
+{
+  return mData;
+}
+
+std::size_t MappedFile::size() const noexcept
+{
+  return mSize;
+}
+
+}
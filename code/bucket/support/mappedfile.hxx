@@ -0,0 +1,51 @@
+// mappedfile.hxx
+// Defines the class MappedFile, which makes the entire contents of a file
+// available as one contiguous, read-only block of memory. Regular files are
+// memory mapped. Anything that cannot be mapped (pipes, character devices,
+// platforms without mmap) is read into an owned buffer instead.
+
+#ifndef BUCKET_SUPPORT_MAPPEDFILE_HXX
+#define BUCKET_SUPPORT_MAPPEDFILE_HXX
+
+#include "common.hxx"
+#include <cstddef>
+#include <memory>
+
+namespace support {
+
+class MappedFile {
+
+public:
+
+  explicit MappedFile(const char* path);
+
+  // Takes ownership of file contents that have already been read.
+  MappedFile(std::unique_ptr<unsigned char[]> contents, std::size_t size) noexcept;
+
+  MappedFile(const MappedFile&) = delete;
+
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile();
+
+  const unsigned char* data() const noexcept;
+
+  std::size_t size() const noexcept;
+
+private:
+
+  const unsigned char* mData;
+
+  std::size_t mSize;
+
+  bool mIsMapped;
+
+  std::unique_ptr<unsigned char[]> mOwnedBuffer;
+
+  void readIntoBuffer(int file_descriptor);
+
+};
+
+}
+
+#endif
@@ -0,0 +1,133 @@
+#include "common.hxx"
+#include "support/streambuffer.hxx"
+#include "support/concatenate.hxx"
+#include "support/utf8.hxx"
+#include <cstring>
+#include <stdexcept>
+
+#ifdef BUCKET_HAVE_POSIX
+  #include <cerrno>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace support {
+
+namespace {
+
+// Returns the length of the longest prefix of the buffer that does not end in
+// the middle of a code point, assuming the buffer will be continued later.
+std::size_t completeSequencesPrefix(const unsigned char* data, std::size_t size) noexcept
+{
+  for (std::size_t back = 1; back <= 3 && back <= size; ++back) {
+    auto byte = data[size - back];
+    if ((byte & 0xC0) == 0x80)
+      continue;
+    std::size_t length = byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : byte >= 0xC0 ? 2 : 1;
+    return length > back ? size - back : size;
+  }
+  return size;
+}
+
+}
+
+StreamBuffer::StreamBuffer(const char* path, std::size_t chunk_size)
+: mOwnsFile{std::strcmp(path, "-") != 0},
+  mEndOfStream{false},
+  mChunkSize{chunk_size},
+  mBuffer{std::make_unique<unsigned char[]>(chunk_size + 3)},
+  mBufferOffset{0},
+  mValidEnd{mBuffer.get()},
+  mReadEnd{mBuffer.get()}
+{
+  #ifdef BUCKET_HAVE_POSIX
+  mFileDescriptor = mOwnsFile ? ::open(path, O_RDONLY) : STDIN_FILENO;
+  if (mFileDescriptor == -1)
+    throw std::runtime_error("unable to open file");
+  #else
+  mFile = mOwnsFile ? std::fopen(path, "rb") : stdin;
+  if (!mFile)
+    throw std::runtime_error("unable to open file");
+  #endif
+}
+
+StreamBuffer::~StreamBuffer()
+{
+  if (!mOwnsFile)
+    return;
+  #ifdef BUCKET_HAVE_POSIX
+  ::close(mFileDescriptor);
+  #else
+  std::fclose(mFile);
+  #endif
+}
+
+bool StreamBuffer::refill()
+{
+  // move the start of a split code point to the front of the buffer
+  auto carried = static_cast<std::size_t>(mReadEnd - mValidEnd);
+  mBufferOffset += static_cast<std::size_t>(mValidEnd - mBuffer.get());
+  std::memmove(mBuffer.get(), mValidEnd, carried);
+  mValidEnd = mBuffer.get();
+  mReadEnd = mBuffer.get() + carried;
+
+  while (!mEndOfStream) {
+    auto bytes_read = readSome(mReadEnd, mChunkSize + 3 - static_cast<std::size_t>(mReadEnd - mBuffer.get()));
+    if (bytes_read == 0) {
+      mEndOfStream = true;
+      break;
+    }
+    mReadEnd += bytes_read;
+
+    // only hand out complete code points; if all that has been read so far is
+    // part of one code point, keep reading
+    auto size = static_cast<std::size_t>(mReadEnd - mBuffer.get());
+    auto complete = completeSequencesPrefix(mBuffer.get(), size);
+    auto invalid_offset = findInvalidUtf8(mBuffer.get(), complete);
+    if (invalid_offset != complete)
+      throw std::runtime_error(concatenate("unable to decode unicode (invalid UTF-8 at byte offset ", mBufferOffset + invalid_offset, ')'));
+    mValidEnd = mBuffer.get() + complete;
+    if (complete != 0)
+      return true;
+  }
+
+  // the stream ended; anything left over is a truncated code point
+  if (mReadEnd != mBuffer.get())
+    throw std::runtime_error(concatenate("unable to decode unicode (invalid UTF-8 at byte offset ", mBufferOffset, ')'));
+  return false;
+}
+
+const unsigned char* StreamBuffer::begin() const noexcept
+{
+  return mBuffer.get();
+}
+
+const unsigned char* StreamBuffer::end() const noexcept
+{
+  return mValidEnd;
+}
+
+std::size_t StreamBuffer::streamOffset(const unsigned char* position) const noexcept
+{
+  return mBufferOffset + static_cast<std::size_t>(position - mBuffer.get());
+}
+
+std::size_t StreamBuffer::readSome(unsigned char* destination, std::size_t size)
+{
+  #ifdef BUCKET_HAVE_POSIX
+  while (true) {
+    auto bytes_read = ::read(mFileDescriptor, destination, size);
+    if (bytes_read >= 0)
+      return static_cast<std::size_t>(bytes_read);
+    if (errno != EINTR)
+      throw std::runtime_error("failed to read from file");
+  }
+  #else
+  auto bytes_read = std::fread(destination, 1, size, mFile);
+  if (bytes_read == 0 && std::ferror(mFile))
+    throw std::runtime_error("failed to read from file");
+  return bytes_read;
+  #endif
+}
+
+}
@@ -0,0 +1,81 @@
+// streambuffer.hxx
+// Defines the class StreamBuffer, which reads input that cannot be mapped
+// (standard input, pipes, character devices) in fixed-size chunks. Only one
+// chunk is held in memory at a time, so arbitrarily long streams are read in
+// bounded memory, and each chunk is handed out as soon as the read returns
+// instead of after the writer closes the stream. Every chunk is validated as
+// UTF-8 before it is handed out.
+
+#ifndef BUCKET_SUPPORT_STREAMBUFFER_HXX
+#define BUCKET_SUPPORT_STREAMBUFFER_HXX
+
+#include "common.hxx"
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+
+namespace support {
+
+class StreamBuffer {
+
+public:
+
+  static constexpr std::size_t DEFAULT_CHUNK_SIZE = 1 << 16;
+
+  // Opens the file at 'path' for streaming; the path "-" denotes standard
+  // input.
+  explicit StreamBuffer(const char* path, std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+  StreamBuffer(const StreamBuffer&) = delete;
+
+  StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+  ~StreamBuffer();
+
+  // Replaces the current chunk with the next one. All of the current chunk
+  // must have been consumed; the bytes of a code point that was split by the
+  // end of the previous read are carried over to the front of the new chunk.
+  // Returns false if the stream has ended.
+  bool refill();
+
+  // The validated bytes of the current chunk.
+  const unsigned char* begin() const noexcept;
+
+  const unsigned char* end() const noexcept;
+
+  // Returns the offset in the stream of the byte at 'position', which must
+  // point into the current chunk.
+  std::size_t streamOffset(const unsigned char* position) const noexcept;
+
+private:
+
+  #ifdef BUCKET_HAVE_POSIX
+  int mFileDescriptor;
+  #else
+  std::FILE* mFile;
+  #endif
+
+  bool mOwnsFile;
+
+  bool mEndOfStream;
+
+  std::size_t mChunkSize;
+
+  std::unique_ptr<unsigned char[]> mBuffer;
+
+  // the stream offset of mBuffer[0]
+  std::size_t mBufferOffset;
+
+  // validated bytes are [mBuffer, mValidEnd), the start of a split code point
+  // is [mValidEnd, mReadEnd)
+  unsigned char* mValidEnd;
+
+  unsigned char* mReadEnd;
+
+  std::size_t readSome(unsigned char* destination, std::size_t size);
+
+};
+
+}
+
+#endif
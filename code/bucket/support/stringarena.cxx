@@ -0,0 +1,30 @@
+#include "common.hxx"
+#include "support/stringarena.hxx"
+#include <algorithm>
+#include <cstring>
+
+namespace support {
+
+StringArena::StringArena() noexcept
+: mBlockCursor(nullptr),
+  mBlockSpace(0)
+{}
+
+std::string_view StringArena::store(std::string_view string)
+{
+  if (string.empty())
+    return std::string_view();
+  if (string.size() > mBlockSpace) {
+    auto size = std::max(string.size(), BLOCK_SIZE);
+    mBlocks.push_back(std::make_unique<char[]>(size));
+    mBlockCursor = mBlocks.back().get();
+    mBlockSpace = size;
+  }
+  auto stored = mBlockCursor;
+  std::memcpy(stored, string.data(), string.size());
+  mBlockCursor += string.size();
+  mBlockSpace -= string.size();
+  return std::string_view(stored, string.size());
+}
+
+}
@@ -0,0 +1,45 @@
+// stringarena.hxx
+// Defines the class StringArena, which stores strings in large blocks that
+// are only freed with the arena. A stored string never moves, so views of it
+// stay valid for as long as the arena lives. An arena is not safe to use from
+// several threads at once.
+
+#ifndef BUCKET_SUPPORT_STRINGARENA_HXX
+#define BUCKET_SUPPORT_STRINGARENA_HXX
+
+#include "common.hxx"
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace support {
+
+class StringArena {
+
+public:
+
+  StringArena() noexcept;
+
+  StringArena(const StringArena&) = delete;
+
+  StringArena& operator=(const StringArena&) = delete;
+
+  // Returns a copy of 'string' owned by the arena.
+  std::string_view store(std::string_view string);
+
+private:
+
+  static constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+  std::vector<std::unique_ptr<char[]>> mBlocks;
+
+  char* mBlockCursor;
+
+  std::size_t mBlockSpace;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,88 @@
+#include "common.hxx"
+#include "support/stringinterner.hxx"
+#include <array>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+namespace support {
+
+StringInterner::StringInterner()
+{
+  mIds.emplace(std::string_view(), 0);
+  mSpellings.emplace_back();
+}
+
+namespace {
+
+// Each thread remembers the strings it interned most recently, so that the
+// same name seen again does not have to take the lock. Stored strings never
+// move or change, so a cached entry stays valid for the interner's lifetime.
+struct CacheEntry {
+  const StringInterner* interner = nullptr;
+  std::string_view spelling;
+  std::uint32_t id = 0;
+};
+
+constexpr std::size_t CACHE_SIZE = 1024;
+
+thread_local std::array<CacheEntry, CACHE_SIZE> cache;
+
+}
+
+std::uint32_t StringInterner::intern(std::string_view string)
+{
+  auto& entry = cache[std::hash<std::string_view>()(string) % CACHE_SIZE];
+  if (entry.interner == this && entry.spelling == string)
+    return entry.id;
+  auto [spelling, id] = find(string);
+  entry = CacheEntry{this, spelling, id};
+  return id;
+}
+
+std::pair<std::string_view, std::uint32_t> StringInterner::find(std::string_view string)
+{
+  {
+    std::shared_lock lock{mMutex};
+    auto iterator = mIds.find(string);
+    if (iterator != mIds.end())
+      return *iterator;
+  }
+  std::unique_lock lock{mMutex};
+  // another thread may have added the string since the lookup above
+  auto iterator = mIds.find(string);
+  if (iterator != mIds.end())
+    return *iterator;
+  if (mSpellings.size() > std::numeric_limits<std::uint32_t>::max())
+    throw std::runtime_error("too many distinct names");
+  auto id = static_cast<std::uint32_t>(mSpellings.size());
+  auto stored = mArena.store(string);
+  mSpellings.push_back(stored);
+  mIds.emplace(stored, id);
+  return {stored, id};
+}
+
+std::string_view StringInterner::spelling(std::uint32_t id) const
+{
+  std::shared_lock lock{mMutex};
+  return mSpellings[id];
+}
+
+std::size_t StringInterner::size() const
+{
+  std::shared_lock lock{mMutex};
+  return mSpellings.size();
+}
+
+StringInterner& StringInterner::global()
+{
+  static StringInterner interner;
+  return interner;
+}
+
+std::ostream& operator<<(std::ostream& stream, InternedString string)
+{
+  return stream << string.spelling();
+}
+
+}
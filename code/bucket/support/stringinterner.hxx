@@ -0,0 +1,132 @@
+// stringinterner.hxx
+// Defines the class StringInterner, which stores each distinct string once and
+// gives it a dense 32-bit id, and the class InternedString, which is such an
+// id. Names travel through the compiler as InternedStrings, so comparing and
+// hashing them are integer operations, and the characters are only looked at
+// again when a name is printed. There is one interner for the whole process,
+// shared by every thread.
+
+#ifndef BUCKET_SUPPORT_STRINGINTERNER_HXX
+#define BUCKET_SUPPORT_STRINGINTERNER_HXX
+
+#include "common.hxx"
+#include "support/stringarena.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace support {
+
+class StringInterner {
+
+public:
+
+  StringInterner();
+
+  StringInterner(const StringInterner&) = delete;
+
+  StringInterner& operator=(const StringInterner&) = delete;
+
+  // Returns the id of 'string', adding it if it has not been seen before.
+  // The empty string always has the id 0.
+  std::uint32_t intern(std::string_view string);
+
+  std::string_view spelling(std::uint32_t id) const;
+
+  // Returns the number of distinct strings, including the empty string.
+  std::size_t size() const;
+
+  static StringInterner& global();
+
+private:
+
+  mutable std::shared_mutex mMutex;
+
+  std::unordered_map<std::string_view, std::uint32_t> mIds;
+
+  std::vector<std::string_view> mSpellings;
+
+  // the characters of every string
+  StringArena mArena;
+
+  // Looks up or adds 'string' under the lock, and returns the stored copy
+  // along with its id.
+  std::pair<std::string_view, std::uint32_t> find(std::string_view string);
+
+};
+
+class InternedString {
+
+public:
+
+  // the empty string
+  constexpr InternedString() noexcept
+  : mId(0)
+  {}
+
+  explicit InternedString(std::string_view string)
+  : mId(StringInterner::global().intern(string))
+  {}
+
+  // Returns the string with an id given out earlier by the global interner.
+  static constexpr InternedString fromId(std::uint32_t id) noexcept
+  {
+    InternedString string;
+    string.mId = id;
+    return string;
+  }
+
+  constexpr std::uint32_t id() const noexcept
+  {
+    return mId;
+  }
+
+  constexpr bool empty() const noexcept
+  {
+    return mId == 0;
+  }
+
+  std::string_view spelling() const
+  {
+    return StringInterner::global().spelling(mId);
+  }
+
+  constexpr bool operator==(InternedString other) const noexcept
+  {
+    return mId == other.mId;
+  }
+
+  constexpr bool operator!=(InternedString other) const noexcept
+  {
+    return mId != other.mId;
+  }
+
+private:
+
+  std::uint32_t mId;
+
+};
+
+std::ostream& operator<<(std::ostream& stream, InternedString string);
+
+}
+
+namespace std {
+
+template <>
+struct hash<support::InternedString> {
+  std::size_t operator()(support::InternedString string) const noexcept
+  {
+    return string.id();
+  }
+};
+
+}
+
+#endif
@@ -2,13 +2,20 @@
 #define BUCKET_SUPPORT_UNICODECHARACTER_HXX
 
 #include "common.hxx"
+#include "support/characterclass.hxx"
+#include "support/utf8.hxx"
 #include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <ostream>
 #include <string_view>
-#include <utf8proc.h>
 
 namespace support {
 
+// A code point together with its UTF-8 encoding, packed into eight bytes so
+// that it is passed and returned in a single register. The number of bytes is
+// stored rather than recomputed from the lead byte.
 class UnicodeCharacter {
 
 friend class UnicodeFileReader;
@@ -17,7 +24,11 @@ public:
 
   UnicodeCharacter() noexcept;
 
-  UnicodeCharacter(int ascii);
+  UnicodeCharacter(int ascii) noexcept;
+
+  // Decodes the code point at 'bytes', which must be valid UTF-8 (see
+  // support/utf8.hxx).
+  static UnicodeCharacter fromValidUtf8(const unsigned char* bytes) noexcept;
 
   bool isEndOfFile() const noexcept;
 
@@ -29,7 +40,11 @@ public:
 
   bool isNumericDigit() const noexcept;
 
-  operator std::string_view() noexcept;
+  bool isIdentifierStart() const noexcept;
+
+  bool isIdentifierContinue() const noexcept;
+
+  operator std::string_view() const noexcept;
 
   std::string_view bytes() const noexcept;
 
@@ -41,16 +56,95 @@ public:
 
 private:
 
-  utf8proc_int32_t mCodePoint;
+  // only the first mNumberOfBytes bytes are meaningful
+  std::array<std::uint8_t, 4> mBytes;
 
-  std::array<utf8proc_uint8_t, 4> mBytes;
+  // -1 at end of file
+  std::int32_t mCodePoint : 24;
 
-  UnicodeCharacter(utf8proc_int32_t code_point, std::array<utf8proc_uint8_t, 4> bytes, unsigned char number_of_bytes) noexcept;
+  std::uint32_t mNumberOfBytes : 8;
 
-  unsigned char numberOfBytes() const noexcept;
+  UnicodeCharacter(std::int32_t code_point, std::array<std::uint8_t, 4> bytes, unsigned char number_of_bytes) noexcept;
 
 };
 
+static_assert(sizeof(UnicodeCharacter) == 8);
+
+inline UnicodeCharacter::UnicodeCharacter() noexcept
+: mBytes{},
+  mCodePoint{-1},
+  mNumberOfBytes{0}
+{}
+
+inline UnicodeCharacter::UnicodeCharacter(int ascii) noexcept
+: mBytes{static_cast<std::uint8_t>(ascii)},
+  mCodePoint{ascii},
+  mNumberOfBytes{1}
+{
+  assert(0 <= ascii && ascii <= 0x7F);
+}
+
+inline UnicodeCharacter::UnicodeCharacter(std::int32_t code_point, std::array<std::uint8_t, 4> bytes, unsigned char number_of_bytes) noexcept
+: mBytes{bytes},
+  mCodePoint{code_point},
+  mNumberOfBytes{number_of_bytes}
+{}
+
+inline UnicodeCharacter UnicodeCharacter::fromValidUtf8(const unsigned char* bytes) noexcept
+{
+  std::int32_t code_point;
+  auto number_of_bytes = decodeValidUtf8(bytes, code_point);
+  std::array<std::uint8_t, 4> copied_bytes{};
+  std::memcpy(copied_bytes.data(), bytes, number_of_bytes);
+  return UnicodeCharacter(code_point, copied_bytes, number_of_bytes);
+}
+
+inline bool UnicodeCharacter::isEndOfFile() const noexcept
+{
+  return mCodePoint == -1;
+}
+
+inline bool UnicodeCharacter::isLetter() const noexcept
+{
+  return characterClasses(mCodePoint) & Letter;
+}
+
+inline int UnicodeCharacter::getAscii() const noexcept
+{
+  // end of file is -1 as well
+  return mCodePoint <= 0x7F ? mCodePoint : -1;
+}
+
+inline bool UnicodeCharacter::isAsciiDigit() const noexcept
+{
+  return static_cast<std::uint32_t>(mCodePoint - '0') < 10;
+}
+
+inline bool UnicodeCharacter::isNumericDigit() const noexcept
+{
+  return characterClasses(mCodePoint) & NumericDigit;
+}
+
+inline bool UnicodeCharacter::isIdentifierStart() const noexcept
+{
+  return characterClasses(mCodePoint) & IdentifierStart;
+}
+
+inline bool UnicodeCharacter::isIdentifierContinue() const noexcept
+{
+  return characterClasses(mCodePoint) & IdentifierContinue;
+}
+
+inline bool UnicodeCharacter::operator==(UnicodeCharacter other) const noexcept
+{
+  return mCodePoint == other.mCodePoint;
+}
+
+inline bool UnicodeCharacter::operator!=(UnicodeCharacter other) const noexcept
+{
+  return !(*this == other);
+}
+
 }
 
 #endif
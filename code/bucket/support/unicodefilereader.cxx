@@ -1,84 +1,194 @@
 #include "common.hxx"
 #include "support/unicodefilereader.hxx"
-#include <cassert>
+#include "support/concatenate.hxx"
+#include "support/utf8.hxx"
+#include <array>
+#include <cstring>
 #include <stdexcept>
+#include <utility>
 
-namespace support {
+#ifdef BUCKET_HAVE_POSIX
+  #include <sys/stat.h>
+#endif
 
-UnicodeFileReader::UnicodeFileReader(const char* path)
-: mFile{path}
-{
-  // check to make sure the file is open
-  if (!mFile)
-    throw std::runtime_error("unable to open file");
+namespace support {
 
-  // read bytes into buffer
-  mFile.read(reinterpret_cast<char*>(mBuffer.data()), 4);
-  if (!mFile && !mFile.eof())
-    throw std::runtime_error("failed to read from file");
+namespace {
 
-  auto bytes_read = mFile.gcount();
-  assert(0 <= bytes_read && bytes_read <= 4);
-  mBytesInBuffer = static_cast<unsigned char>(bytes_read);
+bool shouldStream(const char* path) noexcept
+{
+  if (std::strcmp(path, "-") == 0)
+    return true;
+  #ifdef BUCKET_HAVE_POSIX
+  struct stat status;
+  return ::stat(path, &status) == 0 && !S_ISREG(status.st_mode);
+  #else
+  return false;
+  #endif
+}
 
-  // check for end of file
-  if (mBytesInBuffer == 0)
-    return;
+}
 
-  // check for byte order mark
-  if (mBytesInBuffer >= 3 && mBuffer[0] == 0xEF && mBuffer[1] == 0xBB && mBuffer[2] == 0xBF) {
-    mCodePointLength = 3;
-    next();
+UnicodeFileReader::UnicodeFileReader(const char* path, std::size_t size_limit)
+: mCursor{nullptr},
+  mEnd{nullptr},
+  mSizeLimit{size_limit}
+{
+  if (shouldStream(path)) {
+    // streamed input is validated one chunk at a time by the stream buffer
+    mStream.emplace(path);
+    mStream->refill();
+    mCursor = mStream->begin();
+    mEnd = mStream->end();
+    if (mEnd - mCursor >= 3 && mCursor[0] == 0xEF && mCursor[1] == 0xBB && mCursor[2] == 0xBF)
+      mCursor += 3;
+    checkSize(size());
+    mLineIndex.addChunk(mCursor, static_cast<std::size_t>(mEnd - mCursor), offset());
+    if (mCursor == mEnd)
+      nextChunk();
+  }
+  else {
+    mFile.emplace(path);
+    startWholeFile();
   }
 
-  // decode bytes to get the code point
+  // decode bytes to get the first code point
+  decode();
+}
+
+UnicodeFileReader::UnicodeFileReader(std::unique_ptr<unsigned char[]> contents, std::size_t size, std::size_t size_limit)
+: mFile{std::in_place, std::move(contents), size},
+  mCursor{nullptr},
+  mEnd{nullptr},
+  mSizeLimit{size_limit}
+{
+  startWholeFile();
   decode();
 }
 
 UnicodeCharacter UnicodeFileReader::currentCharacter() const noexcept
 {
-  return mBytesInBuffer == 0 ? UnicodeCharacter() : UnicodeCharacter(mCodePoint, mBuffer, mCodePointLength);
+  return mCurrentCharacter;
 }
 
 void UnicodeFileReader::next()
 {
   // check for eof
-  if (mBytesInBuffer == 0)
+  if (mCursor == mEnd)
     return;
 
-  // remove bytes corresponding to current code point from the buffer and shift
-  // the remaining bytes to the start of the buffer
-  for (unsigned char i = 0; i != 4 - mCodePointLength; ++i)
-    mBuffer[i] = mBuffer[i + mCodePointLength];
+  // step over the bytes of the current code point
+  mCursor += mCurrentCharacter.mNumberOfBytes;
 
-  // get a pointer to the start of the bytes to fill
-  auto bytes_to_fill = reinterpret_cast<char*>(mBuffer.data() + 4 - mCodePointLength);
+  // move on to the next chunk of streamed input
+  if (mCursor == mEnd && mStream)
+    nextChunk();
 
-  // read bytes from file
-  mFile.read(bytes_to_fill, mCodePointLength);
-  if (!mFile && !mFile.eof())
-    throw std::runtime_error("failed to read from file");
-
-  // update the number of bytes in the buffer
-  auto bytes_read = mFile.gcount();
-  assert(0 <= bytes_read && bytes_read <= 4);
-  mBytesInBuffer = mBytesInBuffer - mCodePointLength + static_cast<unsigned char>(bytes_read);
+  // decode bytes to get the code point
+  decode();
+}
 
-  // check for eof
-  if (mBytesInBuffer == 0)
-    return;
+std::string_view UnicodeFileReader::chunk() const noexcept
+{
+  return std::string_view(reinterpret_cast<const char*>(mCursor), static_cast<std::size_t>(mEnd - mCursor));
+}
 
-  // decode bytes to get the code point
+void UnicodeFileReader::skipChunk()
+{
+  mCursor = mEnd;
+  if (mStream)
+    nextChunk();
   decode();
 }
 
-void UnicodeFileReader::decode()
+std::size_t UnicodeFileReader::offset() const noexcept
+{
+  if (mStream)
+    return mStream->streamOffset(mCursor);
+  return static_cast<std::size_t>(mCursor - mFile->data());
+}
+
+LineIndex::LineAndColumn UnicodeFileReader::lineAndColumn(std::size_t offset) const noexcept
 {
-  auto return_code = utf8proc_iterate(mBuffer.data(), mBytesInBuffer, &mCodePoint);
-  if (return_code == UTF8PROC_ERROR_INVALIDUTF8)
-    throw std::runtime_error("unable to decode unicode");
-  assert(return_code == 1 || return_code == 2 || return_code == 3 || return_code == 4);
-  mCodePointLength = static_cast<unsigned char>(return_code);
+  if (mStream)
+    return mLineIndex.resolve(offset, mStream->begin(), mStream->streamOffset(mStream->begin()), static_cast<std::size_t>(mStream->end() - mStream->begin()));
+  return mLineIndex.resolve(offset, mFile->data(), 0, mFile->size());
+}
+
+std::size_t UnicodeFileReader::size() const noexcept
+{
+  if (mStream)
+    return mStream->streamOffset(mStream->end());
+  return mFile->size();
+}
+
+bool UnicodeFileReader::isStreaming() const noexcept
+{
+  return mStream && mCursor != mEnd;
+}
+
+bool UnicodeFileReader::isStreamed() const noexcept
+{
+  return mStream.has_value();
+}
+
+void UnicodeFileReader::nextChunk()
+{
+  // at the end of the stream the chunk is empty, and the cursor must point to
+  // it so that offset() keeps returning the size of the stream
+  auto more = mStream->refill();
+  mCursor = mStream->begin();
+  mEnd = mStream->end();
+  if (more)
+    checkSize(size());
+  // the empty last chunk is added as well, which records the column reached
+  // at the end of the stream; the bytes before it are no longer resident, so
+  // that column could not be counted later
+  mLineIndex.addChunk(mCursor, static_cast<std::size_t>(mEnd - mCursor), offset());
+}
+
+void UnicodeFileReader::startWholeFile()
+{
+  mCursor = mFile->data();
+  mEnd = mFile->data() + mFile->size();
+  checkSize(mFile->size());
+
+  // skip the byte order mark, if there is one
+  if (mEnd - mCursor >= 3 && mCursor[0] == 0xEF && mCursor[1] == 0xBB && mCursor[2] == 0xBF)
+    mCursor += 3;
+
+  // validate the whole file up front, so that decoding never has to check
+  auto size = static_cast<std::size_t>(mEnd - mCursor);
+  auto invalid_offset = findInvalidUtf8(mCursor, size);
+  if (invalid_offset != size) {
+    auto file_offset = invalid_offset + static_cast<std::size_t>(mCursor - mFile->data());
+    throw std::runtime_error(concatenate("unable to decode unicode (invalid UTF-8 at byte offset ", file_offset, ')'));
+  }
+
+  // the whole file is indexed at once
+  mLineIndex.addChunk(mCursor, size, offset());
+}
+
+void UnicodeFileReader::checkSize(std::size_t size) const
+{
+  if (size > mSizeLimit)
+    throw std::runtime_error(concatenate("source file is too large (the limit is ", mSizeLimit, " bytes)"));
+}
+
+void UnicodeFileReader::decode() noexcept
+{
+  if (mCursor == mEnd) {
+    mCurrentCharacter = UnicodeCharacter();
+    return;
+  }
+
+  // copy four bytes at once where the buffer allows it; only the bytes of the
+  // code point itself are used
+  std::array<std::uint8_t, 4> bytes{};
+  std::memcpy(bytes.data(), mCursor, mEnd - mCursor >= 4 ? 4 : static_cast<std::size_t>(mEnd - mCursor));
+  std::int32_t code_point;
+  auto length = decodeValidUtf8(mCursor, code_point);
+  mCurrentCharacter = UnicodeCharacter(code_point, bytes, length);
 }
 
 }
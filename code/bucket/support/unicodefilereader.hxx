@@ -2,10 +2,15 @@
 #define BUCKET_SUPPORT_UNICODEFILEREADER_HXX
 
 #include "common.hxx"
+#include "support/lineindex.hxx"
+#include "support/mappedfile.hxx"
+#include "support/streambuffer.hxx"
 #include "support/unicodecharacter.hxx"
-#include <array>
-#include <fstream>
-#include <utf8proc.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
 
 namespace support {
 
@@ -13,25 +18,73 @@ class UnicodeFileReader {
 
 public:
 
-  explicit UnicodeFileReader(const char* path);
+  static constexpr std::size_t SIZE_LIMIT = UINT32_MAX;
+
+  // Regular files are mapped into memory. Standard input (the path "-"),
+  // pipes, and other files that cannot be mapped are streamed instead. Files
+  // longer than 'size_limit' bytes are rejected, including streams that grow
+  // past it while they are read.
+  explicit UnicodeFileReader(const char* path, std::size_t size_limit = SIZE_LIMIT);
+
+  // Reads a file whose contents have already been loaded into memory.
+  UnicodeFileReader(std::unique_ptr<unsigned char[]> contents, std::size_t size, std::size_t size_limit = SIZE_LIMIT);
 
   UnicodeCharacter currentCharacter() const noexcept;
 
   void next();
 
+  // Returns the bytes from the current character to the end of the part of
+  // the file that is in memory: the rest of the file if it is mapped, the
+  // rest of the current chunk if it is streamed. The bytes are valid UTF-8
+  // and end on a code point boundary; they are empty only at end of file.
+  std::string_view chunk() const noexcept;
+
+  // Moves past the bytes returned by chunk(), reading the next chunk of
+  // streamed input.
+  void skipChunk();
+
+  // Returns the byte offset in the file of the current character.
+  std::size_t offset() const noexcept;
+
+  LineIndex::LineAndColumn lineAndColumn(std::size_t offset) const noexcept;
+
+  // Returns the size of the file in bytes. The size of streamed input is only
+  // known once all of it has been read; until then, this is the number of
+  // bytes read so far.
+  std::size_t size() const noexcept;
+
+  // Returns true if the file is streamed and has not been read to the end.
+  bool isStreaming() const noexcept;
+
+  // Returns true if the file is streamed, in which case the bytes returned
+  // by chunk() are overwritten by the next chunk; otherwise they stay valid
+  // for the lifetime of the reader.
+  bool isStreamed() const noexcept;
+
 private:
 
-  std::ifstream mFile;
+  std::optional<MappedFile> mFile;
+
+  std::optional<StreamBuffer> mStream;
+
+  LineIndex mLineIndex;
+
+  const unsigned char* mCursor;
+
+  const unsigned char* mEnd;
+
+  std::size_t mSizeLimit;
 
-  utf8proc_int32_t mCodePoint;
+  // the decoded character at mCursor
+  UnicodeCharacter mCurrentCharacter;
 
-  std::array<utf8proc_uint8_t, 4> mBuffer;
+  void decode() noexcept;
 
-  unsigned char mBytesInBuffer;
+  void nextChunk();
 
-  unsigned char mCodePointLength;
+  void startWholeFile();
 
-  void decode();
+  void checkSize(std::size_t size) const;
 
 };
 
@@ -0,0 +1,347 @@
+#include "common.hxx"
+#include "support/utf8.hxx"
+#include <cstring>
+
+#ifdef BUCKET_HAVE_X86_SIMD
+  #include <immintrin.h>
+#endif
+
+namespace support {
+
+namespace {
+
+constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+// Validates the single sequence starting at data[i], which must not be ASCII.
+// Returns the offset just past the sequence, or npos if it is invalid. The
+// accepted ranges are those of table 3-7 in the Unicode standard.
+std::size_t validateSequence(const unsigned char* data, std::size_t size, std::size_t i) noexcept
+{
+  auto lead = data[i];
+  std::size_t length;
+  unsigned char lower = 0x80, upper = 0xBF;
+  if (lead >= 0xC2 && lead <= 0xDF)
+    length = 2;
+  else if (lead >= 0xE0 && lead <= 0xEF) {
+    length = 3;
+    if (lead == 0xE0)
+      lower = 0xA0;
+    else if (lead == 0xED)
+      upper = 0x9F;
+  }
+  else if (lead >= 0xF0 && lead <= 0xF4) {
+    length = 4;
+    if (lead == 0xF0)
+      lower = 0x90;
+    else if (lead == 0xF4)
+      upper = 0x8F;
+  }
+  else
+    return npos;
+  if (size - i < length)
+    return npos;
+  if (data[i + 1] < lower || data[i + 1] > upper)
+    return npos;
+  for (std::size_t j = 2; j < length; ++j)
+    if ((data[i + j] & 0xC0) != 0x80)
+      return npos;
+  return i + length;
+}
+
+std::size_t findInvalidUtf8Scalar(const unsigned char* data, std::size_t size, std::size_t i) noexcept
+{
+  while (i < size) {
+    // skip eight ASCII bytes at a time
+    if (size - i >= 8) {
+      std::uint64_t word;
+      std::memcpy(&word, data + i, 8);
+      if ((word & 0x8080808080808080) == 0) {
+        i += 8;
+        continue;
+      }
+    }
+    if (data[i] < 0x80) {
+      i++;
+      continue;
+    }
+    auto next = validateSequence(data, size, i);
+    if (next == npos)
+      return i;
+    i = next;
+  }
+  return size;
+}
+
+// Returns the offset of the sequence that contains the byte just before
+// data[i], or i if no sequence straddles i. Everything before i must already
+// be known to be valid.
+std::size_t sequenceBoundaryBefore(const unsigned char* data, std::size_t i) noexcept
+{
+  for (std::size_t back = 1; back <= 3 && back <= i; ++back)
+    if ((data[i - back] & 0xC0) != 0x80)
+      return i - back;
+  return i;
+}
+
+#ifdef BUCKET_HAVE_X86_SIMD
+
+// The SSE2 kernel only has a fast path for runs of ASCII; SSE2 has no byte
+// shuffle, so everything else goes through the scalar code one sequence at a
+// time.
+__attribute__((target("sse2")))
+std::size_t findInvalidUtf8SSE2(const unsigned char* data, std::size_t size) noexcept
+{
+  std::size_t i = 0;
+  while (i < size) {
+    if (size - i >= 16) {
+      auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+      if (_mm_movemask_epi8(block) == 0) {
+        i += 16;
+        continue;
+      }
+    }
+    if (data[i] < 0x80) {
+      i++;
+      continue;
+    }
+    auto next = validateSequence(data, size, i);
+    if (next == npos)
+      return i;
+    i = next;
+  }
+  return size;
+}
+
+// The AVX2 kernel validates 32 bytes at a time without branching on the
+// contents, using the lookup algorithm of Keiser and Lemire ("Validating UTF-8
+// in less than one instruction per byte", 2021). Each byte pair (previous
+// byte, current byte) is classified with three 16-entry nibble tables whose
+// entries are bit sets of the errors the pair could belong to; a pair is
+// invalid when all three lookups share a bit. The kernel only finds which
+// block contains the first error, so the exact offset is then recovered by the
+// scalar code.
+
+constexpr char TOO_SHORT      = 1 << 0;
+constexpr char TOO_LONG       = 1 << 1;
+constexpr char OVERLONG_3     = 1 << 2;
+constexpr char TOO_LARGE      = 1 << 3;
+constexpr char SURROGATE      = 1 << 4;
+constexpr char OVERLONG_2     = 1 << 5;
+constexpr char TOO_LARGE_1000 = 1 << 6;
+constexpr char OVERLONG_4     = 1 << 6;
+constexpr char TWO_CONTS      = static_cast<char>(1 << 7);
+constexpr char CARRY          = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+__attribute__((target("avx2")))
+inline __m256i lookup16(__m256i table, __m256i nibbles) noexcept
+{
+  return _mm256_shuffle_epi8(table, nibbles);
+}
+
+__attribute__((target("avx2")))
+inline __m256i highNibbles(__m256i bytes) noexcept
+{
+  return _mm256_and_si256(_mm256_srli_epi16(bytes, 4), _mm256_set1_epi8(0x0F));
+}
+
+// Returns the bytes of 'input' shifted N places towards the end, with the last
+// N bytes of 'previous' shifted in at the front.
+template <int N>
+__attribute__((target("avx2")))
+inline __m256i shiftInPrevious(__m256i input, __m256i previous) noexcept
+{
+  return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - N);
+}
+
+__attribute__((target("avx2")))
+__m256i checkBlock(__m256i input, __m256i previous) noexcept
+{
+  const auto byte_1_high_table = _mm256_setr_epi8(
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+    TOO_SHORT | OVERLONG_2,
+    TOO_SHORT,
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+    TOO_SHORT | OVERLONG_2,
+    TOO_SHORT,
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+  );
+  const auto byte_1_low_table = _mm256_setr_epi8(
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+    CARRY | OVERLONG_2,
+    CARRY,
+    CARRY,
+    CARRY | TOO_LARGE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+    CARRY | OVERLONG_2,
+    CARRY,
+    CARRY,
+    CARRY | TOO_LARGE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000
+  );
+  const auto byte_2_high_table = _mm256_setr_epi8(
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+  );
+
+  // errors visible in each (previous byte, current byte) pair
+  auto previous_1 = shiftInPrevious<1>(input, previous);
+  auto special_cases = _mm256_and_si256(
+    _mm256_and_si256(
+      lookup16(byte_1_high_table, highNibbles(previous_1)),
+      lookup16(byte_1_low_table, _mm256_and_si256(previous_1, _mm256_set1_epi8(0x0F)))
+    ),
+    lookup16(byte_2_high_table, highNibbles(input))
+  );
+
+  // bytes two or three places after a three or four byte lead must be
+  // continuation bytes; those positions have the high bit set here
+  auto previous_2 = shiftInPrevious<2>(input, previous);
+  auto previous_3 = shiftInPrevious<3>(input, previous);
+  auto is_third_byte = _mm256_subs_epu8(previous_2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+  auto is_fourth_byte = _mm256_subs_epu8(previous_3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+  auto must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8(static_cast<char>(0x80)));
+
+  return _mm256_xor_si256(must_be_continuation, special_cases);
+}
+
+// Returns nonzero bytes where the block ends in a sequence that needs bytes
+// from the next block.
+__attribute__((target("avx2")))
+inline __m256i isIncomplete(__m256i input) noexcept
+{
+  const auto max_value = _mm256_setr_epi8(
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1)
+  );
+  return _mm256_subs_epu8(input, max_value);
+}
+
+__attribute__((target("avx2")))
+std::size_t findInvalidUtf8AVX2(const unsigned char* data, std::size_t size) noexcept
+{
+  auto previous = _mm256_setzero_si256();
+  auto previous_incomplete = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; size - i >= 32; i += 32) {
+    auto input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    __m256i error;
+    if (_mm256_movemask_epi8(input) == 0) {
+      error = previous_incomplete;
+      previous_incomplete = _mm256_setzero_si256();
+    }
+    else {
+      error = checkBlock(input, previous);
+      previous_incomplete = isIncomplete(input);
+    }
+    if (!_mm256_testz_si256(error, error))
+      break;
+    previous = input;
+  }
+
+  // the first error (if any) is in a sequence that ends at or after i, so the
+  // scalar code takes over from the start of that sequence
+  return findInvalidUtf8Scalar(data, size, sequenceBoundaryBefore(data, i));
+}
+
+#endif
+
+}
+
+std::string_view utf8ValidatorToString(Utf8Validator validator) noexcept
+{
+  switch (validator) {
+    case Utf8Validator::Scalar: return "scalar";
+    case Utf8Validator::SSE2:   return "sse2";
+    case Utf8Validator::AVX2:   return "avx2";
+  }
+  return "";
+}
+
+bool isUtf8ValidatorSupported(Utf8Validator validator) noexcept
+{
+  switch (validator) {
+    case Utf8Validator::Scalar:
+      return true;
+    #ifdef BUCKET_HAVE_X86_SIMD
+    case Utf8Validator::SSE2:
+      return __builtin_cpu_supports("sse2");
+    case Utf8Validator::AVX2:
+      return __builtin_cpu_supports("avx2");
+    #else
+    case Utf8Validator::SSE2:
+    case Utf8Validator::AVX2:
+      return false;
+    #endif
+  }
+  return false;
+}
+
+Utf8Validator fastestUtf8Validator() noexcept
+{
+  static const auto fastest = [] {
+    if (isUtf8ValidatorSupported(Utf8Validator::AVX2))
+      return Utf8Validator::AVX2;
+    if (isUtf8ValidatorSupported(Utf8Validator::SSE2))
+      return Utf8Validator::SSE2;
+    return Utf8Validator::Scalar;
+  }();
+  return fastest;
+}
+
+std::size_t findInvalidUtf8(const unsigned char* data, std::size_t size) noexcept
+{
+  return findInvalidUtf8(data, size, fastestUtf8Validator());
+}
+
+std::size_t findInvalidUtf8(const unsigned char* data, std::size_t size, Utf8Validator validator) noexcept
+{
+  switch (validator) {
+    #ifdef BUCKET_HAVE_X86_SIMD
+    case Utf8Validator::SSE2:
+      return findInvalidUtf8SSE2(data, size);
+    case Utf8Validator::AVX2:
+      return findInvalidUtf8AVX2(data, size);
+    #endif
+    default:
+      return findInvalidUtf8Scalar(data, size, 0);
+  }
+}
+
+}
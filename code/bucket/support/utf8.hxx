@@ -0,0 +1,61 @@
+// utf8.hxx
+// UTF-8 validation and decoding. Source buffers are validated in one pass with
+// findInvalidUtf8(), which picks the fastest kernel the CPU supports. Once a
+// buffer has passed, code points can be decoded from it with decodeValidUtf8(),
+// which does no checking at all.
+
+#ifndef BUCKET_SUPPORT_UTF8_HXX
+#define BUCKET_SUPPORT_UTF8_HXX
+
+#include "common.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace support {
+
+enum class Utf8Validator {
+  Scalar, SSE2, AVX2
+};
+
+std::string_view utf8ValidatorToString(Utf8Validator validator) noexcept;
+
+// Returns whether the running CPU can execute the given validator.
+bool isUtf8ValidatorSupported(Utf8Validator validator) noexcept;
+
+// Returns the fastest validator supported by the running CPU. The CPU is only
+// inspected on the first call.
+Utf8Validator fastestUtf8Validator() noexcept;
+
+// Returns the byte offset of the first byte of the first invalid sequence in
+// the buffer, or 'size' if the whole buffer is valid UTF-8. Overlong
+// encodings, surrogates, code points above U+10FFFF, and sequences truncated by
+// the end of the buffer are all invalid.
+std::size_t findInvalidUtf8(const unsigned char* data, std::size_t size) noexcept;
+
+std::size_t findInvalidUtf8(const unsigned char* data, std::size_t size, Utf8Validator validator) noexcept;
+
+// Decodes the code point starting at 'bytes' and returns its length in bytes.
+// The bytes must have been accepted by findInvalidUtf8().
+inline unsigned char decodeValidUtf8(const unsigned char* bytes, std::int32_t& code_point) noexcept
+{
+  auto lead = bytes[0];
+  if (lead < 0x80) {
+    code_point = lead;
+    return 1;
+  }
+  if (lead < 0xE0) {
+    code_point = ((lead & 0x1F) << 6) | (bytes[1] & 0x3F);
+    return 2;
+  }
+  if (lead < 0xF0) {
+    code_point = ((lead & 0x0F) << 12) | ((bytes[1] & 0x3F) << 6) | (bytes[2] & 0x3F);
+    return 3;
+  }
+  code_point = ((lead & 0x07) << 18) | ((bytes[1] & 0x3F) << 12) | ((bytes[2] & 0x3F) << 6) | (bytes[3] & 0x3F);
+  return 4;
+}
+
+}
+
+#endif
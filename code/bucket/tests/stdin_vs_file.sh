@@ -0,0 +1,70 @@
+#!/bin/sh
+# stdin_vs_file.sh
+# Checks that --lex and --parse print the same output and diagnostics for
+# input streamed from standard input as for the same bytes read from a file,
+# including when the stream is split into several reads at awkward places.
+# Usage: stdin_vs_file.sh path/to/bucket
+
+set -u
+bucket=$1
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+failures=0
+mode=--lex
+
+# check NAME FIRST [SECOND]
+# The input is FIRST followed by SECOND, which is run through $mode. On
+# standard input, SECOND is written after a pause, so that it arrives in a
+# read of its own.
+check() {
+  name=$1
+  first=$2
+  second=${3-}
+  printf '%s%s' "$first" "$second" > "$dir/input.bucket"
+  "$bucket" $mode "$dir/input.bucket" > "$dir/file.out" 2>&1
+  echo "exit $?" >> "$dir/file.out"
+  {
+    printf '%s' "$first"
+    if [ -n "$second" ]; then
+      sleep 0.2
+      printf '%s' "$second"
+    fi
+  } | "$bucket" $mode - > "$dir/stdin.out" 2>&1
+  echo "exit $?" >> "$dir/stdin.out"
+  if ! cmp -s "$dir/file.out" "$dir/stdin.out"; then
+    echo "FAILED: $name"
+    diff "$dir/file.out" "$dir/stdin.out"
+    failures=$((failures + 1))
+  fi
+}
+
+# columns at the end of the input are counted in code points
+check "unclosed string after non-ASCII" '"日本" "unterm'
+check "unclosed block comment after non-ASCII" 'x /* 日本 unclosed'
+check "unclosed string on a later read" '"日本" ' '"unterm'
+check "character literal at the end" "'日"
+
+# a period that ends a read is kept in case a fraction follows it
+check "period at the end of a read" 'x = a .' 'break
+'
+check "fraction after a period at the end of a read" 'x = .' '5
+'
+
+# a streamed file is parsed as its tokens are lexed, not from a token buffer
+mode=--parse
+check "parse across reads" 'class Point
+  x : Int
+  method square() : Int
+    ret x * ' 'x
+  end
+end
+'
+check "lexical error after a read" 'class Point
+  method name() : String
+    ret ' '"unclosed
+'
+
+if [ "$failures" -ne 0 ]; then
+  echo "$failures failed"
+  exit 1
+fi
@@ -0,0 +1,168 @@
+// unicodetablegen.cxx
+// Writes support/unicodetables.hxx, the tables behind support/characterclass,
+// from the utf8proc property database. This program is run as part of the
+// build when BUCKET_GENERATE_UNICODE_TABLES is on; it is the only part of the
+// project that links utf8proc.
+// Usage: bucket_unicodetablegen <output file>
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <utf8proc.h>
+#include <vector>
+
+namespace {
+
+constexpr std::int32_t CODE_SPACE_SIZE = 0x110000;
+
+constexpr std::int32_t BLOCK_SIZE = 256;
+
+struct CodePointRange {
+  std::int32_t first, last;
+};
+
+using BitmapBlock = std::array<std::uint64_t, 2 * BLOCK_SIZE / 64>;
+
+bool isLetter(std::int32_t code_point)
+{
+  switch (utf8proc_category(code_point)) {
+    case UTF8PROC_CATEGORY_LU:
+    case UTF8PROC_CATEGORY_LL:
+    case UTF8PROC_CATEGORY_LT:
+    case UTF8PROC_CATEGORY_LM:
+    case UTF8PROC_CATEGORY_LO:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool isNumericDigit(std::int32_t code_point)
+{
+  return utf8proc_category(code_point) == UTF8PROC_CATEGORY_ND;
+}
+
+// Returns the maximal runs of non-ASCII code points satisfying the predicate.
+// ASCII is left out, since it is always classified by its own table.
+template <typename Predicate>
+std::vector<CodePointRange> findRanges(Predicate predicate)
+{
+  std::vector<CodePointRange> ranges;
+  std::int32_t code_point = 0x80;
+  while (code_point != CODE_SPACE_SIZE) {
+    if (!predicate(code_point)) {
+      code_point++;
+      continue;
+    }
+    auto first = code_point;
+    while (code_point != CODE_SPACE_SIZE && predicate(code_point))
+      code_point++;
+    ranges.push_back({first, code_point - 1});
+  }
+  return ranges;
+}
+
+void setBits(std::vector<BitmapBlock>& blocks, const std::vector<CodePointRange>& ranges, std::size_t first_word)
+{
+  for (auto& range : ranges)
+    for (auto code_point = range.first; code_point <= range.last; ++code_point)
+      blocks[static_cast<std::size_t>(code_point / BLOCK_SIZE)][first_word + static_cast<std::size_t>(code_point % BLOCK_SIZE / 64)] |= std::uint64_t{1} << (code_point % 64);
+}
+
+void writeRanges(std::ostream& stream, const char* name, const std::vector<CodePointRange>& ranges)
+{
+  stream << "constexpr CodePointRange " << name << "[] = {\n";
+  for (auto& range : ranges) {
+    char line[64];
+    std::snprintf(line, sizeof(line), "  {0x%05X, 0x%05X},\n", static_cast<unsigned>(range.first), static_cast<unsigned>(range.last));
+    stream << line;
+  }
+  stream << "};\n";
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 2) {
+    std::cerr << "usage: bucket_unicodetablegen <output file>\n";
+    return 1;
+  }
+
+  auto letter_ranges = findRanges(isLetter);
+  auto numeric_digit_ranges = findRanges(isNumericDigit);
+
+  // build the two-level bitmap from the ranges, storing identical blocks once
+  std::vector<BitmapBlock> all_blocks(CODE_SPACE_SIZE / BLOCK_SIZE);
+  setBits(all_blocks, letter_ranges, 0);
+  setBits(all_blocks, numeric_digit_ranges, BLOCK_SIZE / 64);
+  std::map<BitmapBlock, std::size_t> distinct_block_numbers;
+  std::vector<BitmapBlock> distinct_blocks;
+  std::vector<std::size_t> block_index;
+  for (auto& block : all_blocks) {
+    auto [iter, inserted] = distinct_block_numbers.emplace(block, distinct_blocks.size());
+    if (inserted)
+      distinct_blocks.push_back(block);
+    block_index.push_back(iter->second);
+  }
+
+  std::ofstream stream{argv[1]};
+  stream << "// unicodetables.hxx\n"
+            "// Generated by tools/unicodetablegen.cxx from the property database of\n"
+            "// utf8proc " << utf8proc_version() << ". Do not edit.\n"
+            "\n"
+            "#ifndef BUCKET_SUPPORT_UNICODETABLES_HXX\n"
+            "#define BUCKET_SUPPORT_UNICODETABLES_HXX\n"
+            "\n"
+            "#include \"common.hxx\"\n"
+            "#include <cstdint>\n"
+            "\n"
+            "namespace support {\n"
+            "\n"
+            "namespace unicode_tables {\n"
+            "\n"
+            "struct CodePointRange {\n"
+            "  std::int32_t first, last;\n"
+            "};\n"
+            "\n"
+            "// One " << BLOCK_SIZE << " code point block of the two-level bitmap.\n"
+            "struct BitmapBlock {\n"
+            "  std::uint64_t letter[" << BLOCK_SIZE / 64 << "];\n"
+            "  std::uint64_t numeric_digit[" << BLOCK_SIZE / 64 << "];\n"
+            "};\n"
+            "\n"
+            "// non-ASCII code points in general category L*\n";
+  writeRanges(stream, "letterRanges", letter_ranges);
+  stream << "\n// non-ASCII code points in general category Nd\n";
+  writeRanges(stream, "numericDigitRanges", numeric_digit_ranges);
+  stream << "\n// the index into bitmapBlocks of each block of the code space\n"
+            "constexpr std::uint16_t blockIndex[] = {";
+  for (std::size_t i = 0; i != block_index.size(); ++i)
+    stream << (i % 16 == 0 ? "\n  " : " ") << block_index[i] << ',';
+  stream << "\n};\n"
+            "\n// the distinct blocks of the bitmap\n"
+            "constexpr BitmapBlock bitmapBlocks[] = {\n";
+  for (auto& block : distinct_blocks) {
+    stream << "  {{";
+    for (std::size_t i = 0; i != block.size(); ++i) {
+      char word[32];
+      std::snprintf(word, sizeof(word), "0x%016llX", static_cast<unsigned long long>(block[i]));
+      stream << word << (i == BLOCK_SIZE / 64 - 1 ? "}, {" : i == block.size() - 1 ? "}},\n" : ", ");
+    }
+  }
+  stream << "};\n"
+            "\n"
+            "}\n"
+            "\n"
+            "}\n"
+            "\n"
+            "#endif\n";
+  if (!stream) {
+    std::cerr << "bucket_unicodetablegen: unable to write " << argv[1] << '\n';
+    return 1;
+  }
+  return 0;
+}